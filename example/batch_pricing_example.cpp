@@ -0,0 +1,48 @@
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#include "../src/core/Types.hpp"
+#include "../src/engines/BSEuropeanAnalytic.hpp"
+#include "../src/engines/BinomialCRR.hpp"
+
+int main() {
+    // A small book stored column-wise, as it would come out of a positions table
+    std::vector<double> S{100.0, 100.0, 95.0, 110.0, 120.0};
+    std::vector<double> K{100.0, 105.0, 100.0, 100.0, 110.0};
+    std::vector<double> r{0.05, 0.03, 0.04, 0.02, 0.02};
+    std::vector<double> q{0.02, 0.01, 0.00, 0.00, 0.00};
+    std::vector<double> sig{0.20, 0.25, 0.30, 0.15, 0.20};
+    std::vector<double> T{1.0, 0.5, 0.25, 2.0, 1.0};
+    std::vector<core::OptionType> type{core::OptionType::Call, core::OptionType::Put, core::OptionType::Put,
+                                       core::OptionType::Call, core::OptionType::Put};
+    std::vector<core::ExerciseStyle> exercise(S.size(), core::ExerciseStyle::European);
+
+    core::OptionBatch batch{S, K, r, q, sig, T, type, exercise};
+
+    // Only value and delta are requested; the other output spans stay empty
+    std::vector<double> bs_value(batch.size()), bs_delta(batch.size());
+    engines::PriceOutputsBatch bs_out;
+    bs_out.value = bs_value;
+    bs_out.delta = bs_delta;
+    engines::BSEuropeanAnalytic bs;
+    bs.priceBatch(batch, bs_out);
+
+    std::vector<double> binom_value(batch.size()), binom_delta(batch.size());
+    engines::PriceOutputsBatch binom_out;
+    binom_out.value = binom_value;
+    binom_out.delta = binom_delta;
+    engines::BinomialCRREngine binom(2000, 0.0005);
+    binom.priceBatch(batch, binom_out);
+
+    std::cout << "Batch pricing of " << batch.size() << " European options (SoA inputs/outputs)\n\n";
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        std::cout << std::fixed << std::setprecision(1) << (type[i] == core::OptionType::Call ? "Call" : " Put")
+                  << " S=" << std::setw(5) << S[i] << " K=" << std::setw(5) << K[i] << std::setprecision(6)
+                  << " | BS: " << std::setw(10) << bs_value[i] << " ("
+                  << std::setw(9) << bs_delta[i] << ")  Binomial: " << std::setw(10) << binom_value[i] << " ("
+                  << std::setw(9) << binom_delta[i] << ")\n";
+    }
+
+    return 0;
+}
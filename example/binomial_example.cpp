@@ -13,6 +13,13 @@ void print_greeks(const std::string& label, const engines::PriceOutputs& out) {
               << "  Delta: " << std::setw(10) << out.delta << "  Gamma: " << std::setw(10) << out.gamma << '\n';
 }
 
+void print_tree_greeks(const std::string& label, const engines::PriceOutputs& out) {
+    std::cout << std::fixed << std::setprecision(6);
+    std::cout << std::setw(18) << label << " | Value: " << std::setw(10) << out.value
+              << "  Delta: " << std::setw(10) << out.delta << "  Gamma: " << std::setw(10) << out.gamma
+              << "  Theta: " << std::setw(10) << out.theta << '\n';
+}
+
 }  // namespace
 
 int main() {
@@ -55,5 +62,15 @@ int main() {
     double premium = binom_put_amer.value - binom_put.value;
     std::cout << "  Early exercise premium: " << std::fixed << std::setprecision(6) << premium << '\n';
 
+    // One backward induction: delta, gamma and theta read off the nodes at steps 1 and 2
+    engines::BinomialCRREngine binom_tree(2000);
+    binom_tree.setGreeksMode(engines::GreeksMode::Tree);
+    std::cout << "\nSingle-tree Greeks (GreeksMode::Tree):\n";
+    print_tree_greeks("BS Call", bs_call);
+    print_tree_greeks("European Call", binom_tree.price(euro_call, params));
+    print_tree_greeks("BS Put", bs_put);
+    print_tree_greeks("European Put", binom_tree.price(euro_put, params));
+    print_tree_greeks("American Put", binom_tree.price(amer_put, params));
+
     return 0;
 }
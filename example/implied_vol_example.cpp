@@ -0,0 +1,88 @@
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "../src/core/Types.hpp"
+#include "../src/engines/BSEuropeanAnalytic.hpp"
+#include "../src/engines/BinomialCRR.hpp"
+#include "../src/engines/ImpliedVol.hpp"
+
+namespace {
+
+const char* status_name(engines::ImpliedVolStatus status) {
+    switch (status) {
+        case engines::ImpliedVolStatus::Converged:
+            return "converged";
+        case engines::ImpliedVolStatus::MaxIterations:
+            return "max iterations";
+        case engines::ImpliedVolStatus::BelowIntrinsic:
+            return "below intrinsic";
+        case engines::ImpliedVolStatus::AboveMaximum:
+            return "above maximum";
+    }
+    return "?";
+}
+
+void print_result(const std::string& label, double true_sig, const engines::ImpliedVolResult& res) {
+    std::cout << std::fixed << std::setprecision(10) << std::setw(22) << label << " | true: " << std::setw(12);
+    if (true_sig > 0.0) {
+        std::cout << true_sig;
+    } else {
+        std::cout << "-";
+    }
+    std::cout << "  implied: " << std::setw(12) << res.sig << std::scientific << std::setprecision(1)
+              << "  residual: " << std::setw(8) << res.residual << "  iters: " << std::setw(2) << res.iterations
+              << "  " << status_name(res.status) << '\n';
+}
+
+}  // namespace
+
+int main() {
+    // One expiry's worth of quotes with a skewed smile, priced with Black-Scholes
+    const double S0 = 100.0, r = 0.03, q = 0.01, T = 0.5;
+    std::vector<double> K{60.0, 80.0, 90.0, 100.0, 110.0, 120.0, 150.0};
+    std::vector<double> true_sig{0.42, 0.31, 0.26, 0.22, 0.20, 0.19, 0.21};
+    const std::size_t n = K.size();
+
+    std::vector<double> S(n, S0), rates(n, r), divs(n, q), T_vec(n, T), prices(n);
+    std::vector<core::OptionType> type(n);
+    std::vector<core::ExerciseStyle> exercise(n, core::ExerciseStyle::European);
+    engines::BSEuropeanAnalytic bs;
+    for (std::size_t i = 0; i < n; ++i) {
+        type[i] = K[i] < S0 ? core::OptionType::Put : core::OptionType::Call;
+        core::OptionSpec spec{{K[i], type[i]}, core::ExerciseStyle::European};
+        prices[i] = bs.price(spec, {S0, K[i], r, q, true_sig[i], T}).value;
+    }
+
+    // batch.sig is ignored by the solver; pass the (unused) true vols to fill the span
+    core::OptionBatch batch{S, K, rates, divs, true_sig, T_vec, type, exercise};
+    std::vector<engines::ImpliedVolResult> results(n);
+    engines::ImpliedVolSolver solver;
+    solver.solveBatch(batch, prices, results);
+
+    std::cout << "Implied vols from European quotes (S=100, r=3%, q=1%, T=0.5), batch solve\n\n";
+    for (std::size_t i = 0; i < n; ++i) {
+        std::ostringstream label;
+        label << (type[i] == core::OptionType::Call ? "Call" : "Put ") << " K=" << std::fixed
+              << std::setprecision(0) << K[i] << " @ " << std::setprecision(6) << prices[i];
+        print_result(label.str(), true_sig[i], results[i]);
+    }
+
+    // American put quote inverted on the CRR tree
+    solver.setAmericanTreeSteps(1000);
+    core::OptionSpec amer_put{{110.0, core::OptionType::Put}, core::ExerciseStyle::American};
+    core::OptionParams amer_params{S0, 110.0, 0.05, 0.0, 0.28, 1.0};
+    double amer_price = engines::BinomialCRREngine(1000, 0.0).price(amer_put, amer_params).value;
+    std::cout << "\nAmerican put K=110, r=5%, T=1 (CRR, 1000 steps) @ " << std::fixed << std::setprecision(6)
+              << amer_price << '\n';
+    print_result("American put", 0.28, solver.solve(amer_put, amer_params, amer_price));
+
+    // Quotes outside the no-arbitrage range are reported, not solved
+    std::cout << "\nOut-of-range quotes\n";
+    core::OptionSpec call{{90.0, core::OptionType::Call}, core::ExerciseStyle::European};
+    print_result("Call K=90 @ 5.0", 0.0, solver.solve(call, {S0, 90.0, r, q, 0.0, T}, 5.0));
+    print_result("Call K=90 @ 120.0", 0.0, solver.solve(call, {S0, 90.0, r, q, 0.0, T}, 120.0));
+
+    return 0;
+}
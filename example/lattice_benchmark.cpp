@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <span>
+#include <vector>
+
+#include "../src/core/Types.hpp"
+#include "../src/engines/BinomialCRR.hpp"
+#include "../src/engines/TrinomialTree.hpp"
+
+namespace {
+
+// The original inductions, which evaluate the exercise value with std::pow per node;
+// kept here as the baseline for the timings.
+double crr_pow_reference(const core::OptionSpec& spec, const core::OptionParams& params, std::size_t steps) {
+    double dt = params.T / static_cast<double>(steps);
+    double u = std::exp(params.sig * std::sqrt(dt));
+    double d = 1.0 / u;
+    double disc = std::exp(-params.r * dt);
+    double p = std::clamp((std::exp((params.r - params.q) * dt) - d) / (u - d), 0.0, 1.0);
+
+    std::vector<double> values(steps + 1);
+    double ST = params.S * std::pow(d, static_cast<double>(steps));
+    for (std::size_t i = 0; i <= steps; ++i) {
+        values[i] = spec.payoff(ST);
+        ST *= u / d;
+    }
+    for (std::size_t step = steps; step-- > 0;) {
+        for (std::size_t i = 0; i <= step; ++i) {
+            double continuation = disc * (p * values[i + 1] + (1.0 - p) * values[i]);
+            double node_spot = params.S * std::pow(u, static_cast<double>(i)) *
+                               std::pow(d, static_cast<double>(step - i));
+            values[i] = std::max(continuation, spec.payoff(node_spot));
+        }
+    }
+    return values[0];
+}
+
+double trinomial_pow_reference(const core::OptionSpec& spec, const core::OptionParams& params, std::size_t steps) {
+    double dt = params.T / static_cast<double>(steps);
+    double disc = std::exp(-params.r * dt);
+    double u = std::exp(params.sig * std::sqrt(3.0 * dt));
+    double a = params.r - params.q - 0.5 * params.sig * params.sig;
+    double pu = 1.0 / 6.0 + a * std::sqrt(dt) / (2.0 * params.sig * std::sqrt(3.0));
+    double pd = 1.0 / 3.0 - pu;
+    double pm = 2.0 / 3.0;
+
+    int offset = static_cast<int>(steps);
+    std::vector<double> values(2 * steps + 1), next(2 * steps + 1, 0.0);
+    for (int j = -offset; j <= offset; ++j) {
+        values[j + offset] = spec.payoff(params.S * std::pow(u, static_cast<double>(j)));
+    }
+    for (std::size_t step = steps; step > 0; --step) {
+        int limit = static_cast<int>(step) - 1;
+        for (int j = -limit; j <= limit; ++j) {
+            double continuation = disc * (pu * values[j + 1 + offset] + pm * values[j + offset] +
+                                          pd * values[j - 1 + offset]);
+            next[j + offset] = std::max(continuation, spec.payoff(params.S * std::pow(u, static_cast<double>(j))));
+        }
+        values.swap(next);
+    }
+    return values[offset];
+}
+
+template <typename F>
+double time_ms(F&& f, double& result) {
+    auto start = std::chrono::steady_clock::now();
+    result = f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+}  // namespace
+
+int main() {
+    core::OptionParams params{100.0, 100.0, 0.05, 0.01, 0.20, 1.0};
+    core::OptionSpec amer_put{{params.K, core::OptionType::Put}, core::ExerciseStyle::American};
+
+    std::cout << "American put backward induction, value only (S=100, K=100, r=5%, q=1%, sigma=20%, T=1)\n\n";
+    std::cout << std::setw(10) << "Lattice" << std::setw(7) << "Steps" << std::setw(14) << "pow (ms)"
+              << std::setw(14) << "engine (ms)" << std::setw(10) << "Speedup" << std::setw(12) << "|diff|" << '\n';
+
+    for (std::size_t steps : {1000u, 2000u, 4000u}) {
+        // Bump 0 skips the delta/gamma trees, so the engine runs exactly one induction
+        engines::BinomialCRREngine crr(steps, 0.0);
+        engines::TrinomialTreeEngine trinomial(steps, 0.0);
+        double ref = 0.0, fast = 0.0;
+
+        double t_ref = time_ms([&] { return crr_pow_reference(amer_put, params, steps); }, ref);
+        double t_fast = time_ms([&] { return crr.price(amer_put, params).value; }, fast);
+        std::cout << std::setw(10) << "CRR" << std::setw(7) << steps << std::fixed << std::setprecision(2)
+                  << std::setw(14) << t_ref << std::setw(14) << t_fast << std::setw(9) << t_ref / t_fast << "x"
+                  << std::scientific << std::setprecision(1) << std::setw(12) << std::fabs(ref - fast) << '\n';
+
+        t_ref = time_ms([&] { return trinomial_pow_reference(amer_put, params, steps); }, ref);
+        t_fast = time_ms([&] { return trinomial.price(amer_put, params).value; }, fast);
+        std::cout << std::setw(10) << "Trinomial" << std::setw(7) << steps << std::fixed << std::setprecision(2)
+                  << std::setw(14) << t_ref << std::setw(14) << t_fast << std::setw(9) << t_ref / t_fast << "x"
+                  << std::scientific << std::setprecision(1) << std::setw(12) << std::fabs(ref - fast) << '\n';
+    }
+
+    // A 40-strike American put chain, one price() call per strike against priceChain()
+    std::vector<core::OptionSpec> chain;
+    for (int i = 0; i < 40; ++i) {
+        chain.push_back({{60.0 + 2.0 * i, core::OptionType::Put}, core::ExerciseStyle::American});
+    }
+    std::vector<engines::PriceOutputs> looped(chain.size()), shared(chain.size());
+
+    std::cout << "\n40-strike American put chain, K = 60..138, value only\n\n";
+    std::cout << std::setw(10) << "Lattice" << std::setw(7) << "Steps" << std::setw(14) << "price (ms)"
+              << std::setw(14) << "chain (ms)" << std::setw(10) << "Speedup" << std::setw(12) << "max|diff|"
+              << '\n';
+
+    auto run_chain = [&](const char* name, const engines::PricingEngine& engine, std::size_t steps) {
+        double unused = 0.0;
+        double t_loop = time_ms([&] {
+            for (std::size_t i = 0; i < chain.size(); ++i) {
+                looped[i] = engine.price(chain[i], params);
+            }
+            return 0.0;
+        }, unused);
+        double t_chain = time_ms([&] {
+            engine.priceChain(params, chain, shared);
+            return 0.0;
+        }, unused);
+        double diff = 0.0;
+        for (std::size_t i = 0; i < chain.size(); ++i) {
+            diff = std::max(diff, std::fabs(looped[i].value - shared[i].value));
+        }
+        std::cout << std::setw(10) << name << std::setw(7) << steps << std::fixed << std::setprecision(2)
+                  << std::setw(14) << t_loop << std::setw(14) << t_chain << std::setw(9) << t_loop / t_chain << "x"
+                  << std::scientific << std::setprecision(1) << std::setw(12) << diff << '\n';
+    };
+
+    for (std::size_t steps : {1000u, 4000u}) {
+        run_chain("CRR", engines::BinomialCRREngine(steps, 0.0), steps);
+        run_chain("Trinomial", engines::TrinomialTreeEngine(steps, 0.0), steps);
+    }
+    return 0;
+}
@@ -60,5 +60,14 @@ int main() {
         print_mc("LSMC (" + std::to_string(paths) + ")", out);
     }
 
+    std::cout << "\nAmerican Put bounds (boundary fitted on 50000 paths, priced on 200000 fresh ones):\n";
+    engines::MCAmericanLSMCEngine two_phase(200000, 50, 6262, 3);
+    two_phase.setTrainingPaths(50000);
+    two_phase.setThreadCount(0);
+    auto bounds = two_phase.priceBounds(amer_put, params, 250, 250);
+    print_mc("Out-of-sample", bounds.lower);
+    std::cout << std::setw(18) << "Dual (250 x 250)" << " | Value: " << std::setw(10) << bounds.upper
+              << "  StdErr: " << std::setw(10) << bounds.upper_std_error << '\n';
+
     return 0;
 }
@@ -38,6 +38,20 @@ int main() {
     auto barrier_put_hi = engine_120k_180.price(barrier_spec, barrier_params);
     auto lookback_call_hi = engine_120k_180.price(lookback_spec, lookback_params);
 
+    // Scenario C: multilevel MC, 10 base steps refined per level until RMSE <= 0.02
+    engines::MCPathDependentEngine engine_mlmc(0, 10, 2468u, engines::VarianceReductionMethod::Multilevel);
+    engine_mlmc.setMlmcOptions(0.02);
+    auto asian_call_ml = engine_mlmc.price(asian_spec, asian_params);
+    auto barrier_put_ml = engine_mlmc.price(barrier_spec, barrier_params);
+    auto lookback_call_ml = engine_mlmc.price(lookback_spec, lookback_params);
+
+    // Scenario D: scenario A with control variates (geometric Asian, European options)
+    engines::MCPathDependentEngine engine_cv(60000, 90, 4321u);
+    engine_cv.setControlVariate(true);
+    auto asian_call_cv = engine_cv.price(asian_spec, asian_params);
+    auto barrier_put_cv = engine_cv.price(barrier_spec, barrier_params);
+    auto lookback_call_cv = engine_cv.price(lookback_spec, lookback_params);
+
     std::cout << "Path-Dependent Monte Carlo Examples\n";
     std::cout << "Scenario A: 60k paths, 90 steps\n";
     print_result("Arithmetic Asian Call", asian_call);
@@ -49,5 +63,15 @@ int main() {
     print_result("Down-and-Out Put", barrier_put_hi);
     print_result("Lookback Call", lookback_call_hi);
 
+    std::cout << "\nScenario C: multilevel MC, target RMSE 0.02\n";
+    print_result("Arithmetic Asian Call", asian_call_ml);
+    print_result("Down-and-Out Put", barrier_put_ml);
+    print_result("Lookback Call", lookback_call_ml);
+
+    std::cout << "\nScenario D: 60k paths, 90 steps, control variates\n";
+    print_result("Arithmetic Asian Call", asian_call_cv);
+    print_result("Down-and-Out Put", barrier_put_cv);
+    print_result("Lookback Call", lookback_call_cv);
+
     return 0;
 }
@@ -15,9 +15,11 @@ engines::PriceOutputs run_euro(std::size_t paths,
                                std::uint64_t seed,
                                VR method,
                                const core::OptionSpec& spec,
-                               const core::OptionParams& params) {
+                               const core::OptionParams& params,
+                               bool control_variate = false) {
     engines::MCEuropeanEngine engine(paths, 1, seed,
                                      method == VR::AntitheticMomentMatching ? VR::AntitheticVariates : method);
+    engine.setControlVariate(control_variate);
     return engine.price(spec, params);
 }
 
@@ -26,9 +28,11 @@ engines::PriceOutputs run_amer(std::size_t paths,
                                std::uint64_t seed,
                                VR method,
                                const core::OptionSpec& spec,
-                               const core::OptionParams& params) {
+                               const core::OptionParams& params,
+                               bool control_variate = false) {
     engines::MCAmericanLSMCEngine engine(paths, steps, seed, 2,
                                          method == VR::AntitheticMomentMatching ? VR::AntitheticVariates : method);
+    engine.setControlVariate(control_variate);
     return engine.price(spec, params);
 }
 
@@ -62,6 +66,10 @@ int main() {
                  run_euro(paths, 8200u + paths, VR::MomentMatching, euro_call, euro_params));
         print_mc("MC + Antithetic+Moment",
                  run_euro(paths, 8300u + paths, VR::AntitheticMomentMatching, euro_call, euro_params));
+        print_mc("QMC (Sobol, scrambled)",
+                 run_euro(paths, 8350u + paths, VR::QuasiMonteCarlo, euro_call, euro_params));
+        print_mc("MC + Control (S_T)",
+                 run_euro(paths, 8380u + paths, VR::None, euro_call, euro_params, true));
         std::cout << '\n';
     }
 
@@ -85,6 +93,10 @@ int main() {
                  run_amer(paths, 75, 8600u + paths, VR::MomentMatching, amer_put, amer_params));
         print_mc("MC + Antithetic+Moment",
                  run_amer(paths, 75, 8700u + paths, VR::AntitheticMomentMatching, amer_put, amer_params));
+        print_mc("QMC (Sobol, scrambled)",
+                 run_amer(paths, 75, 8750u + paths, VR::QuasiMonteCarlo, amer_put, amer_params));
+        print_mc("MC + Control (European)",
+                 run_amer(paths, 75, 8780u + paths, VR::None, amer_put, amer_params, true));
         std::cout << '\n';
     }
 
@@ -15,4 +15,4 @@ while IFS= read -r file; do
   src_files+=("$file")
 done < <(find ./src -name '*.cpp' -print)
 
-c++ -std=c++20 -O2 -I./src -I"${inc_dir}/include" example/example_v1.cpp "${src_files[@]}" -o output/example_v1
+c++ -std=c++20 -O2 -pthread -I./src -I"${inc_dir}/include" example/example_v1.cpp "${src_files[@]}" -o output/example_v1
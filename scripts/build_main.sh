@@ -14,4 +14,4 @@ while IFS= read -r file; do
   src_files+=("$file")
 done < <(find ./src -name '*.cpp' -print)
 
-c++ -std=c++20 -O2 -I./src -I"${inc_dir}/include" "${src_files[@]}" -o output/main
+c++ -std=c++20 -O2 -pthread -I./src -I"${inc_dir}/include" "${src_files[@]}" -o output/main
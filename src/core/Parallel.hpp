@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+// Number of workers to use for a requested thread count; 0 means one per hardware thread.
+inline std::size_t resolve_threads(std::size_t requested) {
+    if (requested == 0) {
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw > 0 ? static_cast<std::size_t>(hw) : 1;
+    }
+    return requested;
+}
+
+// Runs body(task) for every task in [0, count) on up to `threads` workers. Tasks are
+// claimed dynamically, so body must not depend on which worker runs it. The first
+// exception thrown by any task is rethrown on the calling thread.
+template <typename Body>
+void parallel_for(std::size_t count, std::size_t threads, Body&& body) {
+    std::size_t workers = std::min(resolve_threads(threads), count);
+    if (workers <= 1) {
+        for (std::size_t task = 0; task < count; ++task) {
+            body(task);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    auto run = [&]() {
+        for (std::size_t task = next++; task < count; task = next++) {
+            try {
+                body(task);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(error_mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                next = count;
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (std::size_t w = 1; w < workers; ++w) {
+        pool.emplace_back(run);
+    }
+    run();
+    for (auto& t : pool) {
+        t.join();
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+// Runs body(worker) for every worker in [0, workers) on its own thread, all at once, for
+// loops whose workers synchronise with each other (e.g. at a std::barrier); the
+// calling thread is worker 0. body must not throw, since a worker that left early
+// would keep the others waiting.
+template <typename Body>
+void parallel_team(std::size_t workers, Body&& body) {
+    std::vector<std::thread> pool;
+    pool.reserve(workers > 0 ? workers - 1 : 0);
+    for (std::size_t w = 1; w < workers; ++w) {
+        pool.emplace_back([&body, w] { body(w); });
+    }
+    body(std::size_t{0});
+    for (auto& t : pool) {
+        t.join();
+    }
+}
+
+} // namespace core
@@ -0,0 +1,35 @@
+#pragma once
+
+// Defined where kernels can be compiled per ISA with __attribute__((target(...))) and
+// dispatched with __builtin_cpu_supports.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CORE_SIMD_X86_DISPATCH 1
+#endif
+
+namespace core {
+
+// Instruction sets the batch kernels are compiled for; each level implies the ones
+// below it.
+enum class SimdLevel { Scalar, AVX2, AVX512 };
+
+// Best level supported by the running CPU (x86-64 with GCC/Clang); Scalar elsewhere,
+// where kernels still auto-vectorise for the compile-time target (e.g. NEON).
+inline SimdLevel detect_simd_level() {
+#ifdef CORE_SIMD_X86_DISPATCH
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+            return SimdLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+            return SimdLevel::AVX2;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+} // namespace core
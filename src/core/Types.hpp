@@ -1,7 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace core {
 
@@ -20,6 +22,14 @@ struct PlainVanillaPayoff {
         }
         return std::max(strike - ST, 0.0);
     }
+
+    // d payoff / d ST, taking 0 at the kink.
+    double slope(double ST) const noexcept {
+        if (type == OptionType::Call) {
+            return ST > strike ? 1.0 : 0.0;
+        }
+        return ST < strike ? -1.0 : 0.0;
+    }
 };
 
 struct OptionSpec {
@@ -36,6 +46,21 @@ struct OptionParams {
     double T{};   // time to maturity (years)
 };
 
+// Structure-of-arrays view over a batch of vanilla options. Every span holds one entry
+// per option; K doubles as the payoff strike.
+struct OptionBatch {
+    std::span<const double> S;
+    std::span<const double> K;
+    std::span<const double> r;
+    std::span<const double> q;
+    std::span<const double> sig;
+    std::span<const double> T;
+    std::span<const OptionType> type;
+    std::span<const ExerciseStyle> exercise;
+
+    std::size_t size() const noexcept { return S.size(); }
+};
+
 struct PathDependentOptionSpec {
     ExoticType type{ExoticType::ArithmeticAsian};
     OptionType option_type{OptionType::Call};
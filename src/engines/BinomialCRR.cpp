@@ -5,50 +5,260 @@
 #include <stdexcept>
 #include <vector>
 
+#include "engines/LatticeKernels.hpp"
+
 namespace engines {
 
+namespace {
+
+// Per-step constants of the CRR tree, with the discount folded into the probabilities.
+struct CrrLattice {
+    double dt{};
+    double u{};
+    double log_u{};
+    double disc_up{};
+    double disc_down{};
+};
+
+CrrLattice crr_lattice(const core::OptionParams& params, std::size_t steps) {
+    CrrLattice tree;
+    tree.dt = params.T / static_cast<double>(steps);
+    tree.log_u = params.sig * std::sqrt(tree.dt);
+    tree.u = std::exp(tree.log_u);
+    double d = 1.0 / tree.u;
+    double disc = std::exp(-params.r * tree.dt);
+    double drift = std::exp((params.r - params.q) * tree.dt);
+    double p = std::clamp((drift - d) / (tree.u - d), 0.0, 1.0);
+    tree.disc_up = disc * p;
+    tree.disc_down = disc * (1.0 - p);
+    return tree;
+}
+
+// Node i at step n sits at spot u^(2i - n), so the whole tree uses the 2N + 1 spots
+// spot u^k, k = -N..N. They are computed once and split by the parity of k + N, which
+// makes each time slice a contiguous run of one array (see slice_spots); the maturity
+// nodes are the even run itself.
+void node_spots(double spot, double log_u, std::size_t steps, std::vector<double>& even,
+                std::vector<double>& odd) {
+    even.resize(steps + 1);
+    odd.resize(steps);
+    for (std::size_t m = 0; m <= 2 * steps; ++m) {
+        double k = static_cast<double>(m) - static_cast<double>(steps);
+        (m % 2 == 0 ? even : odd)[m / 2] = spot * std::exp(log_u * k);
+    }
+}
+
+const double* slice_spots(const std::vector<double>& even, const std::vector<double>& odd, std::size_t steps,
+                          std::size_t step) {
+    std::size_t first = steps - step;
+    return (first % 2 == 0 ? even : odd).data() + first / 2;
+}
+
+// Delta and gamma from trees rebuilt at S e^{+-bump}.
+void bump_greeks(double S, double spot_up, double spot_down, double base, double up, double down,
+                 PriceOutputs& outputs) {
+    double h_up = spot_up - S;
+    double h_down = S - spot_down;
+    double denom_delta = spot_up - spot_down;
+    if (denom_delta > 0.0) {
+        outputs.delta = (up - down) / denom_delta;
+    }
+    double gamma_denom = h_up * h_down * (h_up + h_down);
+    if (h_up > 0.0 && h_down > 0.0 && gamma_denom != 0.0) {
+        outputs.gamma = 2.0 *
+                        (h_down * up - (h_up + h_down) * base + h_up * down) /
+                        gamma_denom;
+    }
+}
+
+} // namespace
+
 double BinomialCRREngine::value_from_tree(const core::OptionSpec& spec,
                                           const core::OptionParams& params,
-                                          double spot) const {
+                                          double spot, TreeNodes* nodes) const {
     if (steps_ == 0 || params.T <= 0.0) {
         return spec.payoff(spot);
     }
 
-    double dt = params.T / static_cast<double>(steps_);
-    double u = std::exp(params.sig * std::sqrt(dt));
-    double d = 1.0 / u;
-    double disc = std::exp(-params.r * dt);
-    double drift = std::exp((params.r - params.q) * dt);
-    double p = (drift - d) / (u - d);
-    p = std::clamp(p, 0.0, 1.0);
-
-    std::vector<double> option_values(steps_ + 1);
-
-    double ST = spot * std::pow(d, static_cast<double>(steps_));
-    double up_over_down = u / d;
-    for (std::size_t i = 0; i <= steps_; ++i) {
-        option_values[i] = spec.payoff(ST);
-        ST *= up_over_down;
-    }
-
-    for (std::size_t step = steps_; step-- > 0;) {
-        for (std::size_t i = 0; i <= step; ++i) {
-            double continuation = disc * (p * option_values[i + 1] +
-                                          (1.0 - p) * option_values[i]);
-            if (spec.exercise == core::ExerciseStyle::American) {
-                double node_spot = spot * std::pow(u, static_cast<double>(i)) *
-                                   std::pow(d, static_cast<double>(step - i));
-                double exercise = spec.payoff(node_spot);
-                option_values[i] = std::max(continuation, exercise);
-            } else {
-                option_values[i] = continuation;
-            }
+    const std::size_t n_steps = steps_;
+    CrrLattice tree = crr_lattice(params, n_steps);
+    std::vector<double> spots_even;
+    std::vector<double> spots_odd;
+    node_spots(spot, tree.log_u, n_steps, spots_even, spots_odd);
+
+    std::vector<double> option_values(n_steps + 1);
+    for (std::size_t i = 0; i <= n_steps; ++i) {
+        option_values[i] = spec.payoff(spots_even[i]);
+    }
+
+    lattice::BinomialStep step_kernel = lattice::binomial_kernel(spec.exercise, spec.payoff.type);
+    for (std::size_t step = n_steps; step-- > 0;) {
+        step_kernel(option_values.data(), slice_spots(spots_even, spots_odd, n_steps, step), step + 1,
+                    tree.disc_up, tree.disc_down, spec.payoff.strike);
+        if (nodes != nullptr && step == 2) {
+            std::copy_n(option_values.begin(), 3, nodes->step2);
+        } else if (nodes != nullptr && step == 1) {
+            std::copy_n(option_values.begin(), 2, nodes->step1);
+            nodes->dt = tree.dt;
+            nodes->u = tree.u;
+            nodes->filled = steps_ >= 2;
         }
     }
 
     return option_values[0];
 }
 
+void BinomialCRREngine::chain_from_tree(const core::OptionParams& params, double spot,
+                                        const lattice::ChainPayoffs& payoffs, std::span<double> values,
+                                        std::span<TreeNodes> nodes) const {
+    constexpr std::size_t B = lattice::CHAIN_BLOCK;
+    const std::size_t n_steps = steps_;
+    const std::size_t rows = n_steps + 1;
+    CrrLattice tree = crr_lattice(params, n_steps);
+    std::vector<double> spots_even;
+    std::vector<double> spots_odd;
+    node_spots(spot, tree.log_u, n_steps, spots_even, spots_odd);
+
+    // One column of `rows` nodes per block of lanes; lane j of the chain is lane j % B
+    // of column j / B.
+    std::vector<double> option_values(payoffs.width() * rows);
+    std::vector<lattice::BinomialChainSweep> kernels;
+    for (const auto& group : payoffs.groups) {
+        for (std::size_t j = group.first; j < group.first + group.lanes; ++j) {
+            double* column = option_values.data() + (j / B) * rows * B;
+            for (std::size_t i = 0; i < rows; ++i) {
+                column[i * B + j % B] = core::PlainVanillaPayoff{payoffs.strike[j], group.type}(spots_even[i]);
+            }
+        }
+        kernels.insert(kernels.end(), group.lanes / B, lattice::binomial_chain_kernel(group.exercise, group.type));
+    }
+    auto node_value = [&](std::size_t lane, std::size_t row) {
+        return option_values[((lane / B) * rows + row) * B + lane % B];
+    };
+
+    // The sweeps stop at steps 2 and 1 so the tree Greeks can read them.
+    std::size_t level = n_steps;  // the columns hold step `level`, rows 0..level
+    while (level > 0) {
+        std::size_t levels = level > 2 ? std::min(lattice::CHAIN_LEVELS, level - 2) : 1;
+        const double* level_spots[lattice::CHAIN_LEVELS];
+        for (std::size_t l = 0; l < levels; ++l) {
+            level_spots[l] = slice_spots(spots_even, spots_odd, n_steps, level - 1 - l);
+        }
+        for (std::size_t b = 0; b < kernels.size(); ++b) {
+            kernels[b](option_values.data() + b * rows * B, level_spots, levels, level,
+                       payoffs.strike.data() + b * B, tree.disc_up, tree.disc_down);
+        }
+        level -= levels;
+
+        if (level != 1 && level != 2) {
+            continue;
+        }
+        for (std::size_t j = 0; j < nodes.size(); ++j) {
+            double* node_values = level == 2 ? nodes[j].step2 : nodes[j].step1;
+            for (std::size_t i = 0; i <= level; ++i) {
+                node_values[i] = node_value(payoffs.lane[j], i);
+            }
+            nodes[j].dt = tree.dt;
+            nodes[j].u = tree.u;
+            nodes[j].filled = steps_ >= 2;
+        }
+    }
+
+    for (std::size_t j = 0; j < values.size(); ++j) {
+        values[j] = node_value(payoffs.lane[j], 0);
+    }
+}
+
+void BinomialCRREngine::greeksFromNodes(const TreeNodes& nodes, double S, PriceOutputs& outputs) {
+    // Node i at step n sits at S u^(2i - n). Theta compares the middle node at step 2
+    // (spot S again, 2 dt later) with the root.
+    double u2 = nodes.u * nodes.u;
+    double delta_up = (nodes.step2[2] - nodes.step2[1]) / (S * u2 - S);
+    double delta_down = (nodes.step2[1] - nodes.step2[0]) / (S - S / u2);
+    outputs.delta = (nodes.step1[1] - nodes.step1[0]) / (S * nodes.u - S / nodes.u);
+    outputs.gamma = (delta_up - delta_down) / (0.5 * (S * u2 - S / u2));
+    outputs.theta = (nodes.step2[1] - outputs.value) / (2.0 * nodes.dt);
+}
+
+void BinomialCRREngine::fillGreeks(const core::OptionSpec& spec, const core::OptionParams& params,
+                                   PriceOutputs& outputs) const {
+    if (greeks_mode_ == GreeksMode::Tree) {
+        if (steps_ < 2) {
+            throw std::invalid_argument("Binomial tree Greeks require at least two steps");
+        }
+        TreeNodes nodes;
+        outputs.value = value_from_tree(spec, params, params.S, &nodes);
+        if (nodes.filled) {
+            greeksFromNodes(nodes, params.S, outputs);
+        }
+        return;
+    }
+
+    double base = value_from_tree(spec, params, params.S);
+    outputs.value = base;
+
+    if (params.S > 0.0 && bump_size_ > 0.0) {
+        double log_bump = bump_size_;
+        double spot_up = params.S * std::exp(log_bump);
+        double spot_down = params.S * std::exp(-log_bump);
+        double up = value_from_tree(spec, params, spot_up);
+        double down = value_from_tree(spec, params, spot_down);
+        bump_greeks(params.S, spot_up, spot_down, base, up, down, outputs);
+    }
+}
+
+void BinomialCRREngine::priceChain(const core::OptionParams& params, std::span<const core::OptionSpec> specs,
+                                   std::span<PriceOutputs> outputs) const {
+    validateChain(specs, outputs);
+    if (steps_ == 0) {
+        throw std::invalid_argument("Binomial engine requires at least one step");
+    }
+    if (greeks_mode_ == GreeksMode::Tree && steps_ < 2) {
+        throw std::invalid_argument("Binomial tree Greeks require at least two steps");
+    }
+    if (specs.empty()) {
+        return;
+    }
+    if (params.T <= 0.0) {
+        // Every contract is worth its payoff; the tree has nothing to share.
+        PricingEngine::priceChain(params, specs, outputs);
+        return;
+    }
+
+    const std::size_t n = specs.size();
+    lattice::ChainPayoffs payoffs(specs);
+    std::vector<double> base(n);
+    std::fill(outputs.begin(), outputs.end(), PriceOutputs{});
+
+    if (greeks_mode_ == GreeksMode::Tree) {
+        std::vector<TreeNodes> nodes(n);
+        chain_from_tree(params, params.S, payoffs, base, nodes);
+        for (std::size_t j = 0; j < n; ++j) {
+            outputs[j].value = base[j];
+            if (nodes[j].filled) {
+                greeksFromNodes(nodes[j], params.S, outputs[j]);
+            }
+        }
+        return;
+    }
+
+    chain_from_tree(params, params.S, payoffs, base);
+    for (std::size_t j = 0; j < n; ++j) {
+        outputs[j].value = base[j];
+    }
+    if (params.S > 0.0 && bump_size_ > 0.0) {
+        double spot_up = params.S * std::exp(bump_size_);
+        double spot_down = params.S * std::exp(-bump_size_);
+        std::vector<double> up(n);
+        std::vector<double> down(n);
+        chain_from_tree(params, spot_up, payoffs, up);
+        chain_from_tree(params, spot_down, payoffs, down);
+        for (std::size_t j = 0; j < n; ++j) {
+            bump_greeks(params.S, spot_up, spot_down, base[j], up[j], down[j], outputs[j]);
+        }
+    }
+}
+
 PriceOutputs BinomialCRREngine::price(const core::OptionSpec& spec,
                                       const core::OptionParams& params) const {
     if (spec.exercise == core::ExerciseStyle::American) {
@@ -68,29 +278,7 @@ PriceOutputs BinomialCRREngine::priceEuropean(const core::OptionSpec& spec,
     euro_spec.exercise = core::ExerciseStyle::European;
 
     PriceOutputs outputs{};
-    double base = value_from_tree(euro_spec, params, params.S);
-    outputs.value = base;
-
-    if (params.S > 0.0 && bump_size_ > 0.0) {
-        double log_bump = bump_size_;
-        double spot_up = params.S * std::exp(log_bump);
-        double spot_down = params.S * std::exp(-log_bump);
-        double up = value_from_tree(euro_spec, params, spot_up);
-        double down = value_from_tree(euro_spec, params, spot_down);
-        double h_up = spot_up - params.S;
-        double h_down = params.S - spot_down;
-        double denom_delta = spot_up - spot_down;
-        if (denom_delta > 0.0) {
-            outputs.delta = (up - down) / denom_delta;
-        }
-        double gamma_denom = h_up * h_down * (h_up + h_down);
-        if (h_up > 0.0 && h_down > 0.0 && gamma_denom != 0.0) {
-            outputs.gamma = 2.0 *
-                            (h_down * up - (h_up + h_down) * base + h_up * down) /
-                            gamma_denom;
-        }
-    }
-
+    fillGreeks(euro_spec, params, outputs);
     outputs.std_dev = 0.0;
     outputs.std_error = 0.0;
     return outputs;
@@ -107,29 +295,7 @@ PriceOutputs BinomialCRREngine::priceAmerican(const core::OptionSpec& spec,
     }
 
     PriceOutputs outputs{};
-    double base = value_from_tree(american_spec, params, params.S);
-    outputs.value = base;
-
-    if (params.S > 0.0 && bump_size_ > 0.0) {
-        double log_bump = bump_size_;
-        double spot_up = params.S * std::exp(log_bump);
-        double spot_down = params.S * std::exp(-log_bump);
-        double up = value_from_tree(american_spec, params, spot_up);
-        double down = value_from_tree(american_spec, params, spot_down);
-        double h_up = spot_up - params.S;
-        double h_down = params.S - spot_down;
-        double denom_delta = spot_up - spot_down;
-        if (denom_delta > 0.0) {
-            outputs.delta = (up - down) / denom_delta;
-        }
-        double gamma_denom = h_up * h_down * (h_up + h_down);
-        if (h_up > 0.0 && h_down > 0.0 && gamma_denom != 0.0) {
-            outputs.gamma = 2.0 *
-                            (h_down * up - (h_up + h_down) * base + h_up * down) /
-                            gamma_denom;
-        }
-    }
-
+    fillGreeks(american_spec, params, outputs);
     outputs.std_dev = 0.0;
     outputs.std_error = 0.0;
     return outputs;
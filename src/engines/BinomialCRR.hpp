@@ -1,18 +1,44 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 
 #include "engines/PricingEngine.hpp"
 
 namespace engines {
 
+namespace lattice {
+struct ChainPayoffs;
+}
+
+// How lattice engines produce delta and gamma: Bump re-runs the tree at S e^{+-bump};
+// Tree reads delta, gamma and theta off the nodes at steps 1 and 2 of the base tree,
+// so one backward induction yields everything.
+enum class GreeksMode { Bump, Tree };
+
 class BinomialCRREngine : public PricingEngine {
   private:
+    // Option values at the first two time steps of the base tree, for GreeksMode::Tree.
+    struct TreeNodes {
+        bool filled{false};
+        double dt{};
+        double u{};
+        double step1[2]{};
+        double step2[3]{};
+    };
+
     double value_from_tree(const core::OptionSpec& spec, const core::OptionParams& params,
-                           double spot) const;
+                           double spot, TreeNodes* nodes = nullptr) const;
+    // One backward induction for the whole chain, values[j] for the j-th spec; needs
+    // at least one step and T > 0.
+    void chain_from_tree(const core::OptionParams& params, double spot, const lattice::ChainPayoffs& payoffs,
+                         std::span<double> values, std::span<TreeNodes> nodes = {}) const;
+    void fillGreeks(const core::OptionSpec& spec, const core::OptionParams& params, PriceOutputs& outputs) const;
+    static void greeksFromNodes(const TreeNodes& nodes, double S, PriceOutputs& outputs);
 
     std::size_t steps_;
     double bump_size_;
+    GreeksMode greeks_mode_{GreeksMode::Bump};
 
   public:
     // Constructor with number of steps and bump size for Greeks
@@ -22,6 +48,15 @@ class BinomialCRREngine : public PricingEngine {
     PriceOutputs price(const core::OptionSpec& spec,
                const core::OptionParams& params) const override;
 
+    // Prices the whole chain on one tree with the strike dimension vectorised; results
+    // match price() per spec, including the Greeks of the current GreeksMode.
+    void priceChain(const core::OptionParams& params, std::span<const core::OptionSpec> specs,
+                    std::span<PriceOutputs> outputs) const override;
+
+    // Tree mode also fills theta and needs at least two steps.
+    void setGreeksMode(GreeksMode mode) { greeks_mode_ = mode; }
+    GreeksMode getGreeksMode() const { return greeks_mode_; }
+
     private:
     // Separate implementations for clarity; public `price()` dispatches
     PriceOutputs priceEuropean(const core::OptionSpec& spec,
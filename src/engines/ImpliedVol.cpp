@@ -0,0 +1,344 @@
+#include "engines/ImpliedVol.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "engines/BinomialCRR.hpp"
+
+namespace engines {
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+constexpr double kInf = std::numeric_limits<double>::infinity();
+
+// Search range for the American tree inversion.
+constexpr double kAmericanMinVol = 1e-4;
+constexpr double kAmericanMaxVol = 10.0;
+
+// Quantities that stay fixed while iterating on one European quote, always stated for
+// the out-of-the-money side.
+struct EuropeanQuote {
+    double S_disc{};         // S e^{-qT}
+    double K_disc{};         // K e^{-rT}
+    double log_moneyness{};  // ln(S_disc / K_disc)
+    double T{};
+    double price{};
+    core::OptionType type{core::OptionType::Call};
+};
+
+// sig is known to lie in (lo, hi).
+struct Bracket {
+    double lo{0.0};
+    double hi{kInf};
+};
+
+void check_inputs(const core::OptionParams& params) {
+    if (params.S <= 0.0 || params.K <= 0.0 || params.T <= 0.0) {
+        throw std::invalid_argument("Implied vol requires positive S, K and T");
+    }
+}
+
+EuropeanQuote make_quote(const core::OptionSpec& spec, const core::OptionParams& params, double price) {
+    EuropeanQuote quote;
+    quote.S_disc = params.S * std::exp(-params.q * params.T);
+    quote.K_disc = params.K * std::exp(-params.r * params.T);
+    quote.log_moneyness = std::log(quote.S_disc / quote.K_disc);
+    quote.T = params.T;
+    quote.price = price;
+    quote.type = spec.payoff.type;
+    // In-the-money quotes are solved as their out-of-the-money parity counterpart, whose
+    // price is the time value alone and so is not swamped by the intrinsic part.
+    double forward_intrinsic = quote.S_disc - quote.K_disc;
+    if (quote.type == core::OptionType::Call && forward_intrinsic > 0.0) {
+        quote.type = core::OptionType::Put;
+        quote.price -= forward_intrinsic;
+    } else if (quote.type == core::OptionType::Put && forward_intrinsic < 0.0) {
+        quote.type = core::OptionType::Call;
+        quote.price += forward_intrinsic;
+    }
+    return quote;
+}
+
+// Fills `result` and returns false when the quote is outside the range Black-Scholes
+// spans as sig goes from 0 to infinity.
+bool within_bounds(const EuropeanQuote& quote, ImpliedVolResult& result) {
+    bool call = quote.type == core::OptionType::Call;
+    double intrinsic = std::max(call ? quote.S_disc - quote.K_disc : quote.K_disc - quote.S_disc, 0.0);
+    double upper = call ? quote.S_disc : quote.K_disc;
+    if (quote.price <= intrinsic) {
+        result = {kNaN, intrinsic - quote.price, 0, ImpliedVolStatus::BelowIntrinsic};
+        return false;
+    }
+    if (quote.price >= upper) {
+        result = {kNaN, upper - quote.price, 0, ImpliedVolStatus::AboveMaximum};
+        return false;
+    }
+    return true;
+}
+
+// Corrado-Miller on the call price (puts via parity); where its discriminant is
+// negative, the inflection point sqrt(2|ln(F/K)|/T), from which Newton is monotone.
+double initial_guess(const EuropeanQuote& quote) {
+    double call = quote.type == core::OptionType::Call ? quote.price
+                                                       : quote.price + quote.S_disc - quote.K_disc;
+    double half_gap = 0.5 * (quote.S_disc - quote.K_disc);
+    double a = call - half_gap;
+    double disc = a * a - 4.0 * half_gap * half_gap / kPi;
+    if (disc >= 0.0) {
+        double guess = std::sqrt(2.0 * kPi / quote.T) * (a + std::sqrt(disc)) / (quote.S_disc + quote.K_disc);
+        if (guess > 0.0) {
+            return guess;
+        }
+    }
+    return std::sqrt(2.0 * std::fabs(quote.log_moneyness) / quote.T);
+}
+
+// Third-order Householder step for f(sig) = BS(sig) - price, using
+// f''/f' = d1 d2 / sig and f'''/f' = (f''/f')^2 - 3 x^2 / (sig^4 T) - T / 4. Steps that
+// leave the bracket are replaced by bisection (or doubling while unbounded above).
+double householder_step(const EuropeanQuote& quote, double sig, double value, double vega, Bracket& bracket) {
+    double f = value - quote.price;
+    if (f > 0.0) {
+        bracket.hi = sig;
+    } else if (f < 0.0) {
+        bracket.lo = sig;
+    } else {
+        return sig;
+    }
+
+    double next = kNaN;
+    if (value < std::numeric_limits<double>::min() || vega < std::numeric_limits<double>::min()) {
+        // Underflowed price or vega carries no usable slope; bisect.
+    } else if (value < 0.5 * quote.price || value > 2.0 * quote.price) {
+        // Far from the root of an out-of-the-money quote BS(sig) behaves like
+        // exp(-c / sig^2), where steps on f crawl or overshoot. ln BS is close to linear
+        // in u = 1 / sig^2, so take the Newton step there.
+        double slope = -0.5 * vega / value * sig * sig * sig;  // d ln BS / du
+        double u = 1.0 / (sig * sig) - std::log(value / quote.price) / slope;
+        next = u > 0.0 ? 1.0 / std::sqrt(u) : kNaN;
+    } else {
+        double x = quote.log_moneyness;
+        double sqrtT = std::sqrt(quote.T);
+        double d1 = x / (sig * sqrtT) + 0.5 * sig * sqrtT;
+        double d2 = d1 - sig * sqrtT;
+        double h2 = d1 * d2 / sig;
+        double h3 = h2 * h2 - 3.0 * x * x / (sig * sig * sig * sig * quote.T) - 0.25 * quote.T;
+        double nu = f / vega;
+        double denom = 1.0 - h2 * nu + h3 * nu * nu / 6.0;
+        double step = denom > 0.0 ? nu * (1.0 - 0.5 * h2 * nu) / denom : nu;
+        next = sig - step;
+    }
+    if (!(next > bracket.lo && next < bracket.hi)) {
+        next = std::isfinite(bracket.hi) ? 0.5 * (bracket.lo + bracket.hi) : 2.0 * sig;
+    }
+    return next;
+}
+
+} // namespace
+
+ImpliedVolSolver::ImpliedVolSolver(double tolerance, std::size_t max_iterations)
+    : tolerance_(tolerance), max_iterations_(max_iterations) {
+    if (tolerance <= 0.0 || max_iterations == 0) {
+        throw std::invalid_argument("Implied vol solver requires a positive tolerance and iteration limit");
+    }
+}
+
+ImpliedVolResult ImpliedVolSolver::solve(const core::OptionSpec& spec, const core::OptionParams& params,
+                                         double price) const {
+    check_inputs(params);
+    if (spec.exercise == core::ExerciseStyle::American) {
+        if (american_steps_ == 0) {
+            throw std::invalid_argument("Implied vol for American quotes requires setAmericanTreeSteps()");
+        }
+        return solveAmerican(spec, params, price);
+    }
+    return solveEuropean(spec, params, price);
+}
+
+ImpliedVolResult ImpliedVolSolver::solveEuropean(const core::OptionSpec& spec, const core::OptionParams& params,
+                                                 double price) const {
+    EuropeanQuote quote = make_quote(spec, params, price);
+    ImpliedVolResult result;
+    if (!within_bounds(quote, result)) {
+        return result;
+    }
+
+    core::OptionSpec euro_spec{{params.K, quote.type}, core::ExerciseStyle::European};
+    core::OptionParams trial = params;
+    Bracket bracket;
+    double sig = initial_guess(quote);
+    for (std::size_t it = 0; it < max_iterations_; ++it) {
+        trial.sig = sig;
+        PriceOutputs out = bs_.price(euro_spec, trial);
+        result.sig = sig;
+        result.residual = out.value - quote.price;
+        result.iterations = it + 1;
+
+        double next = householder_step(quote, sig, out.value, out.vega, bracket);
+        if (std::fabs(next - sig) <= tolerance_) {
+            result.status = ImpliedVolStatus::Converged;
+            return result;
+        }
+        sig = next;
+    }
+    result.status = ImpliedVolStatus::MaxIterations;
+    return result;
+}
+
+ImpliedVolResult ImpliedVolSolver::solveAmerican(const core::OptionSpec& spec, const core::OptionParams& params,
+                                                 double price) const {
+    ImpliedVolResult result;
+    double intrinsic = spec.payoff(params.S);
+    double upper = spec.payoff.type == core::OptionType::Call ? params.S : params.K;
+    if (price <= intrinsic) {
+        return {kNaN, intrinsic - price, 0, ImpliedVolStatus::BelowIntrinsic};
+    }
+    if (price >= upper) {
+        return {kNaN, upper - price, 0, ImpliedVolStatus::AboveMaximum};
+    }
+
+    BinomialCRREngine tree(american_steps_, 0.0);
+    core::OptionParams trial = params;
+    auto f = [&](double sig) {
+        trial.sig = sig;
+        ++result.iterations;
+        return tree.price(spec, trial).value - price;
+    };
+
+    double lo = kAmericanMinVol;
+    double f_lo = f(lo);
+    if (f_lo >= 0.0) {
+        return {kNaN, f_lo, result.iterations, ImpliedVolStatus::BelowIntrinsic};
+    }
+
+    // The European implied vol of the same quote bounds the American one from above.
+    core::OptionSpec euro_spec{spec.payoff, core::ExerciseStyle::European};
+    ImpliedVolResult euro = solveEuropean(euro_spec, params, price);
+    result.iterations += euro.iterations;
+    double hi = euro.status == ImpliedVolStatus::Converged ? euro.sig : 0.3;
+    hi = std::clamp(hi, 2.0 * lo, kAmericanMaxVol);
+    double f_hi = f(hi);
+    while (f_hi < 0.0) {
+        if (hi >= kAmericanMaxVol) {
+            return {kNaN, f_hi, result.iterations, ImpliedVolStatus::AboveMaximum};
+        }
+        lo = hi;
+        f_lo = f_hi;
+        hi = std::min(2.0 * hi, kAmericanMaxVol);
+        f_hi = f(hi);
+    }
+
+    // Illinois variant of regula falsi: halve the stale end's value when the same end
+    // moves twice in a row, which keeps convergence superlinear.
+    int last_side = 0;
+    while (result.iterations < max_iterations_) {
+        double sig = hi - f_hi * (hi - lo) / (f_hi - f_lo);
+        double f_sig = f(sig);
+        result.sig = sig;
+        result.residual = f_sig;
+        if (f_sig > 0.0) {
+            hi = sig;
+            f_hi = f_sig;
+            if (last_side == 1) {
+                f_lo *= 0.5;
+            }
+            last_side = 1;
+        } else {
+            lo = sig;
+            f_lo = f_sig;
+            if (last_side == -1) {
+                f_hi *= 0.5;
+            }
+            last_side = -1;
+        }
+        if (f_sig == 0.0 || hi - lo <= tolerance_) {
+            result.status = ImpliedVolStatus::Converged;
+            return result;
+        }
+    }
+    result.status = ImpliedVolStatus::MaxIterations;
+    return result;
+}
+
+void ImpliedVolSolver::solveBatch(const core::OptionBatch& batch, std::span<const double> prices,
+                                  std::span<ImpliedVolResult> results) const {
+    const std::size_t n = batch.size();
+    if (batch.K.size() != n || batch.r.size() != n || batch.q.size() != n || batch.T.size() != n ||
+        batch.type.size() != n || batch.exercise.size() != n || prices.size() != n || results.size() != n) {
+        throw std::invalid_argument("solveBatch: quote, price and result spans must all have the same length");
+    }
+
+    std::vector<EuropeanQuote> quotes(n);
+    std::vector<Bracket> brackets(n);
+    std::vector<double> sig(n);
+    std::vector<std::size_t> active;
+    for (std::size_t i = 0; i < n; ++i) {
+        core::OptionSpec spec{{batch.K[i], batch.type[i]}, batch.exercise[i]};
+        core::OptionParams params{batch.S[i], batch.K[i], batch.r[i], batch.q[i], 0.0, batch.T[i]};
+        if (spec.exercise == core::ExerciseStyle::American) {
+            results[i] = solve(spec, params, prices[i]);
+            continue;
+        }
+        check_inputs(params);
+        quotes[i] = make_quote(spec, params, prices[i]);
+        results[i] = {};
+        if (within_bounds(quotes[i], results[i])) {
+            sig[i] = initial_guess(quotes[i]);
+            active.push_back(i);
+        }
+    }
+
+    // Each round prices the still-active quotes as one compact batch.
+    std::vector<double> S, K, r, q, s, T, value, vega;
+    std::vector<core::OptionType> type;
+    std::vector<core::ExerciseStyle> exercise;
+    for (std::size_t it = 0; it < max_iterations_ && !active.empty(); ++it) {
+        const std::size_t m = active.size();
+        for (auto* v : {&S, &K, &r, &q, &s, &T, &value, &vega}) {
+            v->resize(m);
+        }
+        type.resize(m);
+        exercise.assign(m, core::ExerciseStyle::European);
+        for (std::size_t k = 0; k < m; ++k) {
+            std::size_t i = active[k];
+            S[k] = batch.S[i];
+            K[k] = batch.K[i];
+            r[k] = batch.r[i];
+            q[k] = batch.q[i];
+            s[k] = sig[i];
+            T[k] = batch.T[i];
+            type[k] = quotes[i].type;
+        }
+
+        core::OptionBatch round{S, K, r, q, s, T, type, exercise};
+        PriceOutputsBatch out;
+        out.value = value;
+        out.vega = vega;
+        bs_.priceBatch(round, out);
+
+        std::size_t still_active = 0;
+        for (std::size_t k = 0; k < m; ++k) {
+            std::size_t i = active[k];
+            ImpliedVolResult& result = results[i];
+            result.sig = sig[i];
+            result.residual = value[k] - quotes[i].price;
+            result.iterations = it + 1;
+
+            double next = householder_step(quotes[i], sig[i], value[k], vega[k], brackets[i]);
+            if (std::fabs(next - sig[i]) <= tolerance_) {
+                result.status = ImpliedVolStatus::Converged;
+                continue;
+            }
+            result.status = ImpliedVolStatus::MaxIterations;
+            sig[i] = next;
+            active[still_active++] = i;
+        }
+        active.resize(still_active);
+    }
+}
+
+} // namespace engines
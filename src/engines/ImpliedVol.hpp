@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+#include "core/Types.hpp"
+#include "engines/BSEuropeanAnalytic.hpp"
+
+namespace engines {
+
+enum class ImpliedVolStatus {
+    Converged,      // |step| fell below the tolerance
+    MaxIterations,  // best iterate returned, not converged
+    BelowIntrinsic, // quote at or below the zero-volatility value; sig is NaN
+    AboveMaximum    // quote at or above the infinite-volatility bound; sig is NaN
+};
+
+// Per-quote result and convergence diagnostics.
+struct ImpliedVolResult {
+    double sig{0.0};
+    double residual{0.0};       // model price at sig minus the quote
+    std::size_t iterations{0};  // pricing calls made
+    ImpliedVolStatus status{ImpliedVolStatus::Converged};
+};
+
+// Inverts Black-Scholes (and optionally the CRR tree for American quotes) for sig.
+// European quotes start from the Corrado-Miller rational guess (Manaster-Koehler
+// inflection point when it has no real root) and take third-order Householder steps,
+// using vega from BSEuropeanAnalytic and the closed-form volga/vega ratios, inside a
+// bracket that falls back to bisection.
+class ImpliedVolSolver {
+  public:
+    explicit ImpliedVolSolver(double tolerance = 1e-12, std::size_t max_iterations = 50);
+
+    // The input sig is ignored. Throws std::invalid_argument for non-positive S, K or
+    // T, or for American quotes unless setAmericanTreeSteps() enabled them.
+    ImpliedVolResult solve(const core::OptionSpec& spec, const core::OptionParams& params, double price) const;
+
+    // Solves every quote of `batch` (batch.sig is ignored). European quotes iterate
+    // together through BSEuropeanAnalytic::priceBatch, so each Householder round runs
+    // the vectorised kernel over the quotes still active; American quotes go through
+    // solve() one by one.
+    void solveBatch(const core::OptionBatch& batch, std::span<const double> prices,
+                    std::span<ImpliedVolResult> results) const;
+
+    // American quotes are inverted on a BinomialCRREngine with this many steps by a
+    // bracketed Illinois secant; 0 (the default) rejects them.
+    void setAmericanTreeSteps(std::size_t steps) { american_steps_ = steps; }
+    std::size_t getAmericanTreeSteps() const { return american_steps_; }
+
+  private:
+    ImpliedVolResult solveEuropean(const core::OptionSpec& spec, const core::OptionParams& params,
+                                   double price) const;
+    ImpliedVolResult solveAmerican(const core::OptionSpec& spec, const core::OptionParams& params,
+                                   double price) const;
+
+    BSEuropeanAnalytic bs_;
+    double tolerance_;
+    std::size_t max_iterations_;
+    std::size_t american_steps_{0};
+};
+
+} // namespace engines
@@ -0,0 +1,417 @@
+#include "engines/LatticeKernels.hpp"
+
+#include <algorithm>
+
+#include "math/FastMath.hpp"  // MATH_FAST_INLINE
+
+namespace engines {
+namespace lattice {
+namespace {
+
+using core::ExerciseStyle;
+using core::OptionType;
+
+// Nodes are processed in fixed-size blocks written through a local buffer: the constant
+// trip count lets GCC vectorise at -O2, and the buffer makes the in-place binomial
+// update alias-free. The tail of each slice runs the same body one node at a time.
+constexpr std::size_t LATTICE_BLOCK = 16;
+
+template <OptionType Type>
+MATH_FAST_INLINE double payoff(double spot, double strike) {
+    return std::max(Type == OptionType::Call ? spot - strike : strike - spot, 0.0);
+}
+
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE double apply_exercise(double continuation, double spot, double strike) {
+    if constexpr (Exercise == ExerciseStyle::American) {
+        return std::max(continuation, payoff<Type>(spot, strike));
+    } else {
+        return continuation;
+    }
+}
+
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE void binomial_step(double* values, const double* spots, std::size_t count, double disc_up,
+                                    double disc_down, double strike) {
+    std::size_t i = 0;
+    for (; i + LATTICE_BLOCK <= count; i += LATTICE_BLOCK) {
+        double block[LATTICE_BLOCK];
+        for (std::size_t k = 0; k < LATTICE_BLOCK; ++k) {
+            double continuation = disc_up * values[i + k + 1] + disc_down * values[i + k];
+            block[k] = apply_exercise<Exercise, Type>(continuation, spots[i + k], strike);
+        }
+        std::copy_n(block, LATTICE_BLOCK, values + i);
+    }
+    for (; i < count; ++i) {
+        double continuation = disc_up * values[i + 1] + disc_down * values[i];
+        values[i] = apply_exercise<Exercise, Type>(continuation, spots[i], strike);
+    }
+}
+
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE void trinomial_step(double* next, const double* prev, const double* spots, std::size_t count,
+                                     double disc_up, double disc_mid, double disc_down, double strike) {
+    std::size_t i = 0;
+    for (; i + LATTICE_BLOCK <= count; i += LATTICE_BLOCK) {
+        double block[LATTICE_BLOCK];
+        for (std::size_t k = 0; k < LATTICE_BLOCK; ++k) {
+            const double* p = prev + i + k;
+            double continuation = disc_up * p[1] + disc_mid * p[0] + disc_down * p[-1];
+            block[k] = apply_exercise<Exercise, Type>(continuation, spots[i + k], strike);
+        }
+        std::copy_n(block, LATTICE_BLOCK, next + i);
+    }
+    for (; i < count; ++i) {
+        const double* p = prev + i;
+        double continuation = disc_up * p[1] + disc_mid * p[0] + disc_down * p[-1];
+        next[i] = apply_exercise<Exercise, Type>(continuation, spots[i], strike);
+    }
+}
+
+// One chain node: out[k] = exercise(disc_up up[k] + disc_mid mid[k] + disc_down down[k]),
+// with the middle term dropped for the binomial tree (mid == nullptr at compile time).
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE void chain_node(double* out, const double* up, const double* down, double spot,
+                                 const double* strikes, double disc_up, double disc_down) {
+    for (std::size_t k = 0; k < CHAIN_BLOCK; ++k) {
+        double continuation = disc_up * up[k] + disc_down * down[k];
+        out[k] = apply_exercise<Exercise, Type>(continuation, spot, strikes[k]);
+    }
+}
+
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE void chain_node(double* out, const double* up, const double* mid, const double* down, double spot,
+                                 const double* strikes, double disc_up, double disc_mid, double disc_down) {
+    for (std::size_t k = 0; k < CHAIN_BLOCK; ++k) {
+        double continuation = disc_up * up[k] + disc_mid * mid[k] + disc_down * down[k];
+        out[k] = apply_exercise<Exercise, Type>(continuation, spot, strikes[k]);
+    }
+}
+
+// Row i of step l + 1 needs rows i and i + 1 of step l, so a sweep up the column can
+// produce step l + 1 one row behind step l. carry[l] holds the previous row of step
+// l + 1; reading row i + 1 of the input yields steps 1..Levels at rows i..i + 1 - Levels,
+// and the last one is written back over input rows that are no longer needed. The first
+// Levels - 1 rows fill the pipeline.
+template <ExerciseStyle Exercise, OptionType Type, std::size_t Levels>
+MATH_FAST_INLINE void binomial_sweep(double* column, const double* const* level_spots, std::size_t top,
+                                     const double* lane_strikes, double disc_up, double disc_down) {
+    constexpr std::size_t B = CHAIN_BLOCK;
+    // Local copies, which the stores to `column` cannot alias.
+    double strikes[B];
+    const double* spots[Levels];
+    std::copy_n(lane_strikes, B, strikes);
+    std::copy_n(level_spots, Levels, spots);
+    double carry[Levels][B];
+    for (std::size_t i = 0; i + 1 < Levels; ++i) {
+        double value[B];
+        chain_node<Exercise, Type>(value, column + (i + 1) * B, column + i * B, spots[0][i], strikes, disc_up,
+                                   disc_down);
+        for (std::size_t l = 1; l <= i; ++l) {
+            double next[B];
+            chain_node<Exercise, Type>(next, value, carry[l - 1], spots[l][i - l], strikes, disc_up, disc_down);
+            std::copy_n(value, B, carry[l - 1]);
+            std::copy_n(next, B, value);
+        }
+        std::copy_n(value, B, carry[i]);
+    }
+    for (std::size_t i = Levels - 1; i < top; ++i) {
+        double value[B];
+        chain_node<Exercise, Type>(value, column + (i + 1) * B, column + i * B, spots[0][i], strikes, disc_up,
+                                   disc_down);
+#pragma GCC unroll 8
+        for (std::size_t l = 1; l < Levels; ++l) {
+            double next[B];
+            chain_node<Exercise, Type>(next, value, carry[l - 1], spots[l][i - l], strikes, disc_up, disc_down);
+            std::copy_n(value, B, carry[l - 1]);
+            std::copy_n(next, B, value);
+        }
+        std::copy_n(value, B, column + (i + 1 - Levels) * B);
+    }
+}
+
+// As binomial_sweep with the three-row stencil: step l + 1 runs one row behind step l,
+// and step l keeps its two previous rows (below[l], centre[l]). Step l is valid from row
+// l, so step Levels starts once 2 Levels - 1 input rows have been read.
+template <ExerciseStyle Exercise, OptionType Type, std::size_t Levels>
+MATH_FAST_INLINE void trinomial_sweep(double* column, const double* spots, std::size_t top,
+                                      const double* lane_strikes, double disc_up, double disc_mid,
+                                      double disc_down) {
+    constexpr std::size_t B = CHAIN_BLOCK;
+    double strikes[B];
+    std::copy_n(lane_strikes, B, strikes);
+    double below[Levels][B];
+    double centre[Levels][B];
+    std::copy_n(column, B, below[0]);
+    std::copy_n(column + B, B, centre[0]);
+    for (std::size_t i = 1; i + 1 < 2 * Levels; ++i) {
+        double value[B];
+        std::copy_n(column + (i + 1) * B, B, value);
+        std::size_t depth = (i + 1) / 2;
+        for (std::size_t l = 1; l <= depth; ++l) {
+            double next[B];
+            chain_node<Exercise, Type>(next, value, centre[l - 1], below[l - 1], spots[i - l + 1], strikes, disc_up,
+                                       disc_mid, disc_down);
+            std::copy_n(centre[l - 1], B, below[l - 1]);
+            std::copy_n(value, B, centre[l - 1]);
+            std::copy_n(next, B, value);
+        }
+        std::copy_n(centre[depth], B, below[depth]);
+        std::copy_n(value, B, centre[depth]);
+    }
+    for (std::size_t i = 2 * Levels - 1; i < top; ++i) {
+        double value[B];
+        std::copy_n(column + (i + 1) * B, B, value);
+#pragma GCC unroll 8
+        for (std::size_t l = 1; l <= Levels; ++l) {
+            double next[B];
+            chain_node<Exercise, Type>(next, value, centre[l - 1], below[l - 1], spots[i - l + 1], strikes, disc_up,
+                                       disc_mid, disc_down);
+            std::copy_n(centre[l - 1], B, below[l - 1]);
+            std::copy_n(value, B, centre[l - 1]);
+            std::copy_n(next, B, value);
+        }
+        std::copy_n(value, B, column + (i + 1 - Levels) * B);
+    }
+}
+
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE void binomial_chain(double* column, const double* const* spots, std::size_t levels,
+                                     std::size_t top, const double* strikes, double disc_up, double disc_down) {
+    static_assert(CHAIN_LEVELS == 4);
+    switch (levels) {
+        case 1:
+            return binomial_sweep<Exercise, Type, 1>(column, spots, top, strikes, disc_up, disc_down);
+        case 2:
+            return binomial_sweep<Exercise, Type, 2>(column, spots, top, strikes, disc_up, disc_down);
+        case 3:
+            return binomial_sweep<Exercise, Type, 3>(column, spots, top, strikes, disc_up, disc_down);
+        default:
+            return binomial_sweep<Exercise, Type, 4>(column, spots, top, strikes, disc_up, disc_down);
+    }
+}
+
+template <ExerciseStyle Exercise, OptionType Type>
+MATH_FAST_INLINE void trinomial_chain(double* column, const double* spots, std::size_t levels, std::size_t top,
+                                      const double* strikes, double disc_up, double disc_mid, double disc_down) {
+    static_assert(CHAIN_LEVELS == 4);
+    switch (levels) {
+        case 1:
+            return trinomial_sweep<Exercise, Type, 1>(column, spots, top, strikes, disc_up, disc_mid, disc_down);
+        case 2:
+            return trinomial_sweep<Exercise, Type, 2>(column, spots, top, strikes, disc_up, disc_mid, disc_down);
+        case 3:
+            return trinomial_sweep<Exercise, Type, 3>(column, spots, top, strikes, disc_up, disc_mid, disc_down);
+        default:
+            return trinomial_sweep<Exercise, Type, 4>(column, spots, top, strikes, disc_up, disc_mid, disc_down);
+    }
+}
+
+#ifdef CORE_SIMD_X86_DISPATCH
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx512f,avx512dq,fma"))) void binomial_avx512(double* values, const double* spots,
+                                                                     std::size_t count, double up, double down,
+                                                                     double strike) {
+    binomial_step<E, T>(values, spots, count, up, down, strike);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx2,fma"))) void binomial_avx2(double* values, const double* spots, std::size_t count,
+                                                       double up, double down, double strike) {
+    binomial_step<E, T>(values, spots, count, up, down, strike);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx512f,avx512dq,fma"))) void trinomial_avx512(double* next, const double* prev,
+                                                                      const double* spots, std::size_t count,
+                                                                      double up, double mid, double down,
+                                                                      double strike) {
+    trinomial_step<E, T>(next, prev, spots, count, up, mid, down, strike);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx2,fma"))) void trinomial_avx2(double* next, const double* prev, const double* spots,
+                                                        std::size_t count, double up, double mid, double down,
+                                                        double strike) {
+    trinomial_step<E, T>(next, prev, spots, count, up, mid, down, strike);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx512f,avx512dq,fma"))) void binomial_chain_avx512(double* column, const double* const* spots,
+                                                                           std::size_t levels, std::size_t top,
+                                                                           const double* strikes, double up,
+                                                                           double down) {
+    binomial_chain<E, T>(column, spots, levels, top, strikes, up, down);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx2,fma"))) void binomial_chain_avx2(double* column, const double* const* spots,
+                                                             std::size_t levels, std::size_t top,
+                                                             const double* strikes, double up, double down) {
+    binomial_chain<E, T>(column, spots, levels, top, strikes, up, down);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx512f,avx512dq,fma"))) void trinomial_chain_avx512(double* column, const double* spots,
+                                                                            std::size_t levels, std::size_t top,
+                                                                            const double* strikes, double up,
+                                                                            double mid, double down) {
+    trinomial_chain<E, T>(column, spots, levels, top, strikes, up, mid, down);
+}
+template <ExerciseStyle E, OptionType T>
+__attribute__((target("avx2,fma"))) void trinomial_chain_avx2(double* column, const double* spots,
+                                                              std::size_t levels, std::size_t top,
+                                                              const double* strikes, double up, double mid,
+                                                              double down) {
+    trinomial_chain<E, T>(column, spots, levels, top, strikes, up, mid, down);
+}
+#endif
+template <ExerciseStyle E, OptionType T>
+void binomial_chain_baseline(double* column, const double* const* spots, std::size_t levels, std::size_t top,
+                             const double* strikes, double up, double down) {
+    binomial_chain<E, T>(column, spots, levels, top, strikes, up, down);
+}
+template <ExerciseStyle E, OptionType T>
+void trinomial_chain_baseline(double* column, const double* spots, std::size_t levels, std::size_t top,
+                              const double* strikes, double up, double mid, double down) {
+    trinomial_chain<E, T>(column, spots, levels, top, strikes, up, mid, down);
+}
+template <ExerciseStyle E, OptionType T>
+void binomial_baseline(double* values, const double* spots, std::size_t count, double up, double down,
+                       double strike) {
+    binomial_step<E, T>(values, spots, count, up, down, strike);
+}
+template <ExerciseStyle E, OptionType T>
+void trinomial_baseline(double* next, const double* prev, const double* spots, std::size_t count, double up,
+                        double mid, double down, double strike) {
+    trinomial_step<E, T>(next, prev, spots, count, up, mid, down, strike);
+}
+
+template <ExerciseStyle E, OptionType T>
+BinomialStep pick_binomial(core::SimdLevel level) {
+#ifdef CORE_SIMD_X86_DISPATCH
+    switch (level) {
+        case core::SimdLevel::AVX512:
+            return binomial_avx512<E, T>;
+        case core::SimdLevel::AVX2:
+            return binomial_avx2<E, T>;
+        case core::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    (void)level;
+    return binomial_baseline<E, T>;
+}
+
+template <ExerciseStyle E, OptionType T>
+TrinomialStep pick_trinomial(core::SimdLevel level) {
+#ifdef CORE_SIMD_X86_DISPATCH
+    switch (level) {
+        case core::SimdLevel::AVX512:
+            return trinomial_avx512<E, T>;
+        case core::SimdLevel::AVX2:
+            return trinomial_avx2<E, T>;
+        case core::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    (void)level;
+    return trinomial_baseline<E, T>;
+}
+
+template <ExerciseStyle E, OptionType T>
+BinomialChainSweep pick_binomial_chain(core::SimdLevel level) {
+#ifdef CORE_SIMD_X86_DISPATCH
+    switch (level) {
+        case core::SimdLevel::AVX512:
+            return binomial_chain_avx512<E, T>;
+        case core::SimdLevel::AVX2:
+            return binomial_chain_avx2<E, T>;
+        case core::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    (void)level;
+    return binomial_chain_baseline<E, T>;
+}
+
+template <ExerciseStyle E, OptionType T>
+TrinomialChainSweep pick_trinomial_chain(core::SimdLevel level) {
+#ifdef CORE_SIMD_X86_DISPATCH
+    switch (level) {
+        case core::SimdLevel::AVX512:
+            return trinomial_chain_avx512<E, T>;
+        case core::SimdLevel::AVX2:
+            return trinomial_chain_avx2<E, T>;
+        case core::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    (void)level;
+    return trinomial_chain_baseline<E, T>;
+}
+
+} // namespace
+
+ChainPayoffs::ChainPayoffs(std::span<const core::OptionSpec> specs) : lane(specs.size()) {
+    for (ExerciseStyle exercise : {ExerciseStyle::European, ExerciseStyle::American}) {
+        for (OptionType type : {OptionType::Call, OptionType::Put}) {
+            Group group{exercise, type, strike.size(), 0};
+            for (std::size_t i = 0; i < specs.size(); ++i) {
+                if (specs[i].exercise == exercise && specs[i].payoff.type == type) {
+                    lane[i] = strike.size();
+                    strike.push_back(specs[i].payoff.strike);
+                }
+            }
+            if (strike.size() == group.first) {
+                continue;
+            }
+            while ((strike.size() - group.first) % CHAIN_BLOCK != 0) {
+                strike.push_back(strike.back());
+            }
+            group.lanes = strike.size() - group.first;
+            groups.push_back(group);
+        }
+    }
+}
+
+BinomialStep binomial_kernel(ExerciseStyle exercise, OptionType type, core::SimdLevel max_level) {
+    core::SimdLevel level = std::min(core::detect_simd_level(), max_level);
+    bool call = type == OptionType::Call;
+    if (exercise == ExerciseStyle::American) {
+        return call ? pick_binomial<ExerciseStyle::American, OptionType::Call>(level)
+                    : pick_binomial<ExerciseStyle::American, OptionType::Put>(level);
+    }
+    return call ? pick_binomial<ExerciseStyle::European, OptionType::Call>(level)
+                : pick_binomial<ExerciseStyle::European, OptionType::Put>(level);
+}
+
+TrinomialStep trinomial_kernel(ExerciseStyle exercise, OptionType type, core::SimdLevel max_level) {
+    core::SimdLevel level = std::min(core::detect_simd_level(), max_level);
+    bool call = type == OptionType::Call;
+    if (exercise == ExerciseStyle::American) {
+        return call ? pick_trinomial<ExerciseStyle::American, OptionType::Call>(level)
+                    : pick_trinomial<ExerciseStyle::American, OptionType::Put>(level);
+    }
+    return call ? pick_trinomial<ExerciseStyle::European, OptionType::Call>(level)
+                : pick_trinomial<ExerciseStyle::European, OptionType::Put>(level);
+}
+
+BinomialChainSweep binomial_chain_kernel(ExerciseStyle exercise, OptionType type, core::SimdLevel max_level) {
+    core::SimdLevel level = std::min(core::detect_simd_level(), max_level);
+    bool call = type == OptionType::Call;
+    if (exercise == ExerciseStyle::American) {
+        return call ? pick_binomial_chain<ExerciseStyle::American, OptionType::Call>(level)
+                    : pick_binomial_chain<ExerciseStyle::American, OptionType::Put>(level);
+    }
+    return call ? pick_binomial_chain<ExerciseStyle::European, OptionType::Call>(level)
+                : pick_binomial_chain<ExerciseStyle::European, OptionType::Put>(level);
+}
+
+TrinomialChainSweep trinomial_chain_kernel(ExerciseStyle exercise, OptionType type, core::SimdLevel max_level) {
+    core::SimdLevel level = std::min(core::detect_simd_level(), max_level);
+    bool call = type == OptionType::Call;
+    if (exercise == ExerciseStyle::American) {
+        return call ? pick_trinomial_chain<ExerciseStyle::American, OptionType::Call>(level)
+                    : pick_trinomial_chain<ExerciseStyle::American, OptionType::Put>(level);
+    }
+    return call ? pick_trinomial_chain<ExerciseStyle::European, OptionType::Call>(level)
+                : pick_trinomial_chain<ExerciseStyle::European, OptionType::Put>(level);
+}
+
+} // namespace lattice
+} // namespace engines
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "core/Simd.hpp"
+#include "core/Types.hpp"
+
+// Backward-induction kernels shared by the lattice engines. Each is instantiated per
+// exercise style and option type, so the early-exercise test and the payoff are fixed
+// at compile time, and compiled for AVX-512, AVX2 and the baseline ISA; the *_kernel
+// functions return the best variant the CPU supports (capped at `max_level`).
+namespace engines {
+namespace lattice {
+
+// values[i] = max(disc_up values[i + 1] + disc_down values[i], payoff(spots[i])) for
+// i < count, in place; the max is dropped for European exercise.
+using BinomialStep = void (*)(double* values, const double* spots, std::size_t count, double disc_up,
+                              double disc_down, double strike);
+
+// next[i] = max(disc_up prev[i + 1] + disc_mid prev[i] + disc_down prev[i - 1],
+// payoff(spots[i])) for i < count; prev[-1] and prev[count] must be readable.
+using TrinomialStep = void (*)(double* next, const double* prev, const double* spots, std::size_t count,
+                               double disc_up, double disc_mid, double disc_down, double strike);
+
+// Strike dimension of a chain priced on one tree. Contracts are grouped by exercise
+// style and option type, so each group runs a kernel with both fixed at compile time,
+// and every group is padded to whole blocks of CHAIN_BLOCK lanes. Each block is a
+// column of the tree with node values interleaved [node][lane]:
+// column[i * CHAIN_BLOCK + k] is lane k at node row i.
+constexpr std::size_t CHAIN_BLOCK = 8;
+
+// Time steps one chain sweep fuses: the intermediate steps stay in registers, so the
+// column is read and written once per CHAIN_LEVELS steps instead of once per step.
+constexpr std::size_t CHAIN_LEVELS = 4;
+
+struct ChainPayoffs {
+    struct Group {
+        core::ExerciseStyle exercise;
+        core::OptionType type;
+        std::size_t first;  // first lane
+        std::size_t lanes;  // multiple of CHAIN_BLOCK
+    };
+
+    std::vector<double> strike;     // per lane; padding lanes repeat a real strike
+    std::vector<std::size_t> lane;  // lane of specs[i]
+    std::vector<Group> groups;
+
+    explicit ChainPayoffs(std::span<const core::OptionSpec> specs);
+
+    std::size_t width() const { return strike.size(); }
+};
+
+// Advances one column by `levels` (1..CHAIN_LEVELS) steps in place. Rows 0..top hold
+// the input step; on return rows 0..top - levels hold the output, and spots[l] are the
+// node spots of the (l + 1)-th step produced.
+using BinomialChainSweep = void (*)(double* column, const double* const* spots, std::size_t levels,
+                                    std::size_t top, const double* strikes, double disc_up, double disc_down);
+
+// As above for the trinomial tree, where node spots do not depend on the step: rows
+// 0..top in, rows levels..top - levels out (top >= 2 levels).
+using TrinomialChainSweep = void (*)(double* column, const double* spots, std::size_t levels, std::size_t top,
+                                     const double* strikes, double disc_up, double disc_mid, double disc_down);
+
+BinomialStep binomial_kernel(core::ExerciseStyle exercise, core::OptionType type,
+                             core::SimdLevel max_level = core::SimdLevel::AVX512);
+TrinomialStep trinomial_kernel(core::ExerciseStyle exercise, core::OptionType type,
+                               core::SimdLevel max_level = core::SimdLevel::AVX512);
+BinomialChainSweep binomial_chain_kernel(core::ExerciseStyle exercise, core::OptionType type,
+                                         core::SimdLevel max_level = core::SimdLevel::AVX512);
+TrinomialChainSweep trinomial_chain_kernel(core::ExerciseStyle exercise, core::OptionType type,
+                                           core::SimdLevel max_level = core::SimdLevel::AVX512);
+
+} // namespace lattice
+} // namespace engines
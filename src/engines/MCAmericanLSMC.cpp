@@ -5,131 +5,303 @@
 #include <stdexcept>
 #include <vector>
 
+#include "core/Parallel.hpp"
+#include "engines/BSEuropeanAnalytic.hpp"
+#include "math/LeastSquares.hpp"
+#include "math/Random.hpp"
 #include "math/Stats.hpp"
 
 namespace engines {
 
 namespace {
 
-std::vector<double> laguerreBasis(double x, int degree) {
-    // Generate Laguerre polynomial basis up to given degree at x
-    int deg = std::max(0, degree);
-    std::vector<double> basis(deg + 1, 0.0);
-    if (basis.empty()) {
-        return basis;
-    }
-
-    basis[0] = 1.0;
-    if (deg >= 1) {
-        basis[1] = 1.0 - x;
+// Paths per task of an exercise date. Each task gathers its in-the-money paths into
+// its own slice of the design matrix and sums its own A^T A and A^T b; the partials are
+// merged in task order, so results do not depend on the thread count.
+constexpr std::size_t PATHS_PER_TASK = 16384;
+
+// Substream bit of the dual bound's outer and nested paths, disjoint from the
+// (date, task) streams of regenerated paths and the block streams of simulatePaths.
+constexpr std::uint64_t DUAL_STREAM = std::uint64_t{1} << 63;
+
+// Laguerre polynomials L_0..L_degree of each of `rows` points x by the three-term
+// recurrence, one column per degree (L_n at basis + n * stride).
+inline void laguerreColumns(const double* x, std::size_t rows, std::size_t stride, int degree, double* basis) {
+    std::fill_n(basis, rows, 1.0);
+    if (degree >= 1) {
+        double* l1 = basis + stride;
+        for (std::size_t i = 0; i < rows; ++i) {
+            l1[i] = 1.0 - x[i];
+        }
     }
-    for (int n = 2; n <= deg; ++n) {
-        basis[n] = ((2.0 * n - 1.0 - x) * basis[n - 1] - (n - 1.0) * basis[n - 2]) / static_cast<double>(n);
+    for (int n = 2; n <= degree; ++n) {
+        double* ln = basis + static_cast<std::size_t>(n) * stride;
+        const double* l1 = ln - stride;
+        const double* l2 = l1 - stride;
+        for (std::size_t i = 0; i < rows; ++i) {
+            ln[i] = ((2.0 * n - 1.0 - x[i]) * l1[i] - (n - 1.0) * l2[i]) / static_cast<double>(n);
+        }
     }
-    return basis;
 }
 
-bool solveNormalEquations(std::vector<double>& ata, std::vector<double>& atb, int n) {
-    // beta solver via Gaussian elimination with partial pivoting
-    const double eps = 1e-12;
-    for (int col = 0; col < n; ++col) {
-        int pivot = col;
-        double max_val = std::fabs(ata[col * n + col]);
-        for (int row = col + 1; row < n; ++row) {
-            double val = std::fabs(ata[row * n + col]);
-            if (val > max_val) {
-                max_val = val;
-                pivot = row;
-            }
+// Columns L_0..L_N with the recurrence unrolled at compile time: each column's
+// coefficients are constants and its loop is straight-line.
+template <int N>
+inline void laguerreColumnsUpTo(const double* x, std::size_t rows, std::size_t stride, double* basis) {
+    if constexpr (N == 0) {
+        std::fill_n(basis, rows, 1.0);
+    } else if constexpr (N == 1) {
+        laguerreColumnsUpTo<0>(x, rows, stride, basis);
+        double* l1 = basis + stride;
+        for (std::size_t i = 0; i < rows; ++i) {
+            l1[i] = 1.0 - x[i];
         }
-        if (max_val < eps) {
-            return false;
+    } else {
+        laguerreColumnsUpTo<N - 1>(x, rows, stride, basis);
+        constexpr double a = 2.0 * N - 1.0;
+        constexpr double b = N - 1.0;
+        constexpr double n = N;
+        double* ln = basis + static_cast<std::size_t>(N) * stride;
+        const double* l1 = ln - stride;
+        const double* l2 = l1 - stride;
+        for (std::size_t i = 0; i < rows; ++i) {
+            ln[i] = ((a - x[i]) * l1[i] - b * l2[i]) / n;
         }
-        if (pivot != col) {
-            for (int k = col; k < n; ++k) {
-                std::swap(ata[col * n + k], ata[pivot * n + k]);
+    }
+}
+
+// Degrees 1-5 are instantiated with the recurrence unrolled; other degrees use the
+// runtime loop.
+template <int Degree>
+void fillBasis(const double* x, std::size_t rows, std::size_t stride, int, double* basis) {
+    laguerreColumnsUpTo<Degree>(x, rows, stride, basis);
+}
+
+void fillBasisRuntime(const double* x, std::size_t rows, std::size_t stride, int degree, double* basis) {
+    laguerreColumns(x, rows, stride, degree, basis);
+}
+
+using BasisFill = void (*)(const double* x, std::size_t rows, std::size_t stride, int degree, double* basis);
+
+BasisFill basisFill(int degree) {
+    switch (degree) {
+        case 1: return fillBasis<1>;
+        case 2: return fillBasis<2>;
+        case 3: return fillBasis<3>;
+        case 4: return fillBasis<4>;
+        case 5: return fillBasis<5>;
+        default: return fillBasisRuntime;
+    }
+}
+
+// Scratch for one price() call, sized once and reused at every exercise date so the
+// backward induction does not allocate (beyond the solver's first QR fallback). Rows
+// of task t start at begin[t]: t * PATHS_PER_TASK as gathered, or packed contiguously
+// by compactRows().
+struct LsmcWorkspace {
+    std::size_t cols;
+    std::size_t stride;            // rows reserved per basis column
+    std::size_t tasks;
+    std::vector<std::size_t> begin;
+    std::vector<std::size_t> count;
+    std::vector<std::size_t> itm;  // in-the-money path of each row
+    std::vector<double> x;         // its normalised spot
+    std::vector<double> cf;        // its discounted cash flow
+    std::vector<double> exercise;  // its intrinsic value
+    std::vector<double> basis;     // design matrix, column-major
+    std::vector<double> continuation;
+    std::vector<math::lsq::NormalEquations> partials;
+    math::lsq::NormalEquations normal;
+    math::lsq::LeastSquaresSolver solver;
+    std::vector<double> coefficients;
+    // Path Greeks only (empty otherwise): date and spot of each path's current exercise,
+    // with `step` the date being processed.
+    std::vector<std::size_t> stop_step;
+    std::vector<double> stop_spot;
+    std::size_t step{0};
+
+    LsmcWorkspace(std::size_t paths, int degree, math::lsq::Method method)
+        : cols(static_cast<std::size_t>(degree) + 1), stride(paths),
+          tasks((paths + PATHS_PER_TASK - 1) / PATHS_PER_TASK), begin(tasks), count(tasks), itm(paths), x(paths),
+          cf(paths), exercise(paths), basis(paths * cols), continuation(paths),
+          partials(tasks, math::lsq::NormalEquations(cols)), normal(cols), solver(method), coefficients(cols) {}
+
+    math::lsq::DesignMatrix design(std::size_t first, std::size_t rows) const {
+        return {basis.data() + first, rows, cols, stride};
+    }
+};
+
+// Packs the rows of all tasks into one contiguous design matrix, in path order, for
+// solvers that need A itself; returns the row count.
+std::size_t compactRows(LsmcWorkspace& ws) {
+    std::size_t rows = 0;
+    for (std::size_t task = 0; task < ws.tasks; ++task) {
+        const std::size_t from = ws.begin[task];
+        const std::size_t n = ws.count[task];
+        if (from != rows) {
+            // Rows only move down, so a forward copy is safe.
+            std::copy_n(ws.itm.begin() + from, n, ws.itm.begin() + rows);
+            std::copy_n(ws.cf.begin() + from, n, ws.cf.begin() + rows);
+            std::copy_n(ws.exercise.begin() + from, n, ws.exercise.begin() + rows);
+            for (std::size_t c = 0; c < ws.cols; ++c) {
+                double* column = ws.basis.data() + c * ws.stride;
+                std::copy_n(column + from, n, column + rows);
             }
-            std::swap(atb[col], atb[pivot]);
+            ws.begin[task] = rows;
         }
+        rows += n;
+    }
+    return rows;
+}
 
-        double pivot_val = ata[col * n + col];
-        double inv_pivot = 1.0 / pivot_val;
-        for (int k = col; k < n; ++k) {
-            ata[col * n + k] *= inv_pivot;
+// One exercise date of the backward induction. `cashflows` hold each path's cash flow
+// discounted to the next date; on return they are discounted to this one, with
+// in-the-money paths exercised where intrinsic value beats the fitted continuation.
+// Returns false, leaving ws.coefficients untouched, when no path is in the money.
+template <typename Real>
+bool exerciseDate(const core::OptionSpec& spec, const Real* spots, double discount, double inv_scale,
+                  BasisFill fill, int degree, std::size_t threads, std::vector<double>& cashflows,
+                  LsmcWorkspace& ws) {
+    const std::size_t paths = cashflows.size();
+    // Gather the in-the-money paths of each task and evaluate their basis once; the same
+    // rows serve the regression and the exercise decision.
+    core::parallel_for(ws.tasks, threads, [&](std::size_t task) {
+        const std::size_t first = task * PATHS_PER_TASK;
+        const std::size_t last = std::min(paths, first + PATHS_PER_TASK);
+        std::size_t row = first;
+        for (std::size_t path = first; path < last; ++path) {
+            cashflows[path] *= discount;
+            double spot = static_cast<double>(spots[path]);
+            double intrinsic = spec.payoff(spot);
+            if (intrinsic <= 0.0) {
+                continue;
+            }
+            ws.itm[row] = path;
+            ws.x[row] = std::max(spot, 0.0) * inv_scale;
+            ws.cf[row] = cashflows[path];
+            ws.exercise[row] = intrinsic;
+            ++row;
         }
-        atb[col] *= inv_pivot;
+        ws.begin[task] = first;
+        ws.count[task] = row - first;
+        fill(ws.x.data() + first, row - first, ws.stride, degree, ws.basis.data() + first);
+        ws.partials[task].reset(ws.cols);
+        ws.partials[task].accumulate(ws.design(first, row - first), ws.cf.data() + first, 0, row - first);
+    });
+
+    std::size_t rows = 0;
+    ws.normal.reset(ws.cols);
+    for (std::size_t task = 0; task < ws.tasks; ++task) {
+        ws.normal.add(ws.partials[task]);
+        rows += ws.count[task];
+    }
+    if (rows == 0) {
+        return false;
+    }
+    if (!ws.solver.solveNormal(ws.normal, ws.coefficients.data())) {
+        compactRows(ws);
+        ws.solver.solve(ws.normal, ws.design(0, rows), ws.cf.data(), ws.coefficients.data());
+    }
 
-        for (int row = 0; row < n; ++row) {
-            if (row == col) {
-                continue;
+    core::parallel_for(ws.tasks, threads, [&](std::size_t task) {
+        const std::size_t first = ws.begin[task];
+        const std::size_t last = first + ws.count[task];
+        double* value = ws.continuation.data();
+        std::fill(value + first, value + last, 0.0);
+        for (std::size_t c = 0; c < ws.cols; ++c) {
+            const double* column = ws.basis.data() + c * ws.stride;
+            double coeff = ws.coefficients[c];
+            for (std::size_t i = first; i < last; ++i) {
+                value[i] += coeff * column[i];
             }
-            double factor = ata[row * n + col];
-            for (int k = col; k < n; ++k) {
-                ata[row * n + k] -= factor * ata[col * n + k];
+        }
+        for (std::size_t i = first; i < last; ++i) {
+            if (ws.exercise[i] > value[i]) {
+                cashflows[ws.itm[i]] = ws.exercise[i];
+                if (!ws.stop_step.empty()) {
+                    ws.stop_step[ws.itm[i]] = ws.step;
+                    ws.stop_spot[ws.itm[i]] = static_cast<double>(spots[ws.itm[i]]);
+                }
             }
-            atb[row] -= factor * atb[col];
         }
-    }
+    });
     return true;
 }
 
-std::vector<double> regressContinuation(const std::vector<double>& spots,
-                                        const std::vector<double>& discounted_cf,
-                                        int degree,
-                                        double scale) {
-    // Perform least squares regression to find continuation value coefficients
-    int deg = std::max(0, degree);
-    int cols = deg + 1;
-    std::vector<double> coefficients(cols, 0.0);
-    if (spots.empty()) {
-        return coefficients;
+// Starts every path stopped at maturity, for path Greeks.
+template <typename Real>
+void trackStops(LsmcWorkspace& ws, const Real* terminal, std::size_t paths, std::size_t steps) {
+    ws.stop_step.assign(paths, steps);
+    ws.stop_spot.resize(paths);
+    for (std::size_t i = 0; i < paths; ++i) {
+        ws.stop_spot[i] = static_cast<double>(terminal[i]);
     }
+}
 
-    std::vector<double> ata(cols * cols, 0.0);
-    std::vector<double> atb(cols, 0.0);
-    double inv_scale = (scale > 1e-12) ? 1.0 / scale : 1.0;
-
-    for (std::size_t i = 0; i < spots.size(); ++i) {
-        double x = std::max(spots[i], 0.0) * inv_scale;
-        auto basis = laguerreBasis(x, deg);
-        for (int r = 0; r < cols; ++r) {
-            for (int c = 0; c < cols; ++c) {
-                ata[r * cols + c] += basis[r] * basis[c];
-            }
-            atb[r] += basis[r] * discounted_cf[i];
-        }
+// Pathwise delta and vega of each path's cash flow, discounted to date 1 like the cash
+// flows. The exercise dates are held fixed: at the optimal rule their own sensitivity
+// drops out to first order.
+void stopGreeks(const LsmcWorkspace& ws, const core::OptionSpec& spec, const GbmPathGreeks& greeks,
+                double discount, std::vector<double>& delta, std::vector<double>& vega) {
+    const std::size_t paths = ws.stop_step.size();
+    delta.resize(paths);
+    vega.resize(paths);
+    for (std::size_t i = 0; i < paths; ++i) {
+        const std::size_t step = ws.stop_step[i];
+        const double spot = ws.stop_spot[i];
+        double slope = spec.payoff.slope(spot) * std::pow(discount, static_cast<double>(step - 1));
+        delta[i] = slope * greeks.spotDelta(spot);
+        vega[i] = slope * greeks.spotVega(spot, step);
     }
+}
 
-    if (!solveNormalEquations(ata, atb, cols)) {
-        coefficients.assign(cols, 0.0);
-        coefficients[0] = math::stats::mean(discounted_cf);
-        return coefficients;
-    }
+}  // namespace
 
-    return atb;  // solution stored in RHS vector
+void MCAmericanLSMCEngine::ExercisePolicy::reset(std::size_t dates, int basis_degree, double scale) {
+    steps = dates;
+    degree = basis_degree;
+    inv_scale = scale;
+    coefficients.assign((steps + 1) * static_cast<std::size_t>(degree + 1), 0.0);
+    fitted.assign(steps + 1, 0);
 }
 
-double evaluateContinuation(double spot, const std::vector<double>& coeffs, int degree, double scale) {
-    if (coeffs.empty()) {
-        return 0.0;
+void MCAmericanLSMCEngine::ExercisePolicy::record(std::size_t step, const double* beta) {
+    std::copy_n(beta, degree + 1, coefficients.begin() + step * static_cast<std::size_t>(degree + 1));
+    fitted[step] = 1;
+}
+
+bool MCAmericanLSMCEngine::ExercisePolicy::exercise(std::size_t step, double spot, double intrinsic) const {
+    if (intrinsic <= 0.0 || !fitted[step]) {
+        return false;
     }
-    double inv_scale = (scale > 1e-12) ? 1.0 / scale : 1.0;
-    auto basis = laguerreBasis(std::max(spot, 0.0) * inv_scale, std::max(0, degree));
-    double value = 0.0;
-    for (std::size_t i = 0; i < coeffs.size() && i < basis.size(); ++i) {
-        value += coeffs[i] * basis[i];
+    // Same recurrence and summation order as the induction, so a training path gets the
+    // decision it got there.
+    const double x = std::max(spot, 0.0) * inv_scale;
+    const double* beta = coefficients.data() + step * static_cast<std::size_t>(degree + 1);
+    double value = beta[0];
+    double l2 = 1.0;
+    double l1 = 1.0 - x;
+    if (degree >= 1) {
+        value += beta[1] * l1;
+    }
+    for (int n = 2; n <= degree; ++n) {
+        double ln = ((2.0 * n - 1.0 - x) * l1 - (n - 1.0) * l2) / static_cast<double>(n);
+        value += beta[n] * ln;
+        l2 = l1;
+        l1 = ln;
     }
-    return value;
+    return intrinsic > value;
 }
 
-}  // namespace
-
 PriceOutputs MCAmericanLSMCEngine::price(const core::OptionSpec& spec,
                                          const core::OptionParams& params) const {
     // American options only
     if (spec.exercise != core::ExerciseStyle::American) {
         throw std::invalid_argument("MCAmericanLSMCEngine: American exercise style required");
     }
+    if (vr_method_ == VarianceReductionMethod::Multilevel) {
+        throw std::invalid_argument("MCAmericanLSMCEngine: Multilevel Monte Carlo is not supported");
+    }
 
     // Handle edge cases
     if (params.T <= 0.0 || params.sig <= 0.0) {
@@ -138,84 +310,355 @@ PriceOutputs MCAmericanLSMCEngine::price(const core::OptionSpec& spec,
         return outputs;
     }
 
-    std::size_t steps = std::max<std::size_t>(1, time_steps_);
-    double dt = params.T / static_cast<double>(steps);
-    double discount = std::exp(-params.r * dt);
-    double scale = params.K > 1e-12 ? params.K : std::max(params.S, 1.0);
-
-    auto paths = generatePaths(params);
-    if (paths.empty()) {
+    if (paths_ == 0) {
         PriceOutputs outputs{};
         outputs.value = spec.payoff(params.S);
         return outputs;
     }
+    if (policy_) {
+        return priceOutOfSample(spec, params, *policy_);
+    }
+    if (training_paths_ > 0) {
+        return priceOutOfSample(spec, params, fitPolicy(spec, params));
+    }
+    if (regenerate_paths_) {
+        return priceRegenerated(spec, params);
+    }
+    if (path_precision_ == PathPrecision::Float) {
+        return priceOnPaths(spec, params, generatePaths<float>(params));
+    }
+    return priceOnPaths(spec, params, generatePaths<double>(params));
+}
+
+template <typename Real>
+PriceOutputs MCAmericanLSMCEngine::priceOnPaths(const core::OptionSpec& spec, const core::OptionParams& params,
+                                                const TimeMajorPaths<Real>& paths) const {
+    const std::size_t steps = paths.steps;
+    double dt = params.T / static_cast<double>(steps);
+    double discount = std::exp(-params.r * dt);
+    double scale = params.K > 1e-12 ? params.K : std::max(params.S, 1.0);
 
-    std::vector<double> cashflows(paths_);
+    DateOneValues values;
+    std::vector<double>& cashflows = values.cashflows;
+    cashflows.resize(paths_);
+    const Real* terminal = paths.row(steps);
     for (std::size_t i = 0; i < paths_; ++i) {
-        cashflows[i] = spec.payoff(paths[i][steps]);
+        cashflows[i] = spec.payoff(static_cast<double>(terminal[i]));
+    }
+    if (control_variate_) {
+        values.control = cashflows;
     }
 
     int degree = std::max(0, polynomial_degree_);
+    double inv_scale = (scale > 1e-12) ? 1.0 / scale : 1.0;
+    LsmcWorkspace ws(paths_, degree, regression_method_);
+    if (path_greeks_) {
+        trackStops(ws, terminal, paths_, steps);
+    }
+    BasisFill fill = basisFill(degree);
     for (std::size_t step = steps; step-- > 1;) {
-        // Discount future cash flows to current time index
-        for (double& cf : cashflows) {
-            cf *= discount;
-        }
+        ws.step = step;
+        exerciseDate(spec, paths.row(step), discount, inv_scale, fill, degree, threads_, cashflows, ws);
+    }
+    if (path_greeks_) {
+        stopGreeks(ws, spec, GbmPathGreeks(params, steps), discount, values.delta, values.vega);
+    }
 
-        std::vector<double> itm_spots;
-        std::vector<double> itm_cf;
-        itm_spots.reserve(paths_);
-        itm_cf.reserve(paths_);
+    return settle(spec, params, discount, values);
+}
 
-        for (std::size_t path = 0; path < paths_; ++path) {
-            double spot = paths[path][step];
-            double intrinsic = spec.payoff(spot);
-            if (intrinsic <= 0.0) {
-                continue;
+PriceOutputs MCAmericanLSMCEngine::priceRegenerated(const core::OptionSpec& spec,
+                                                    const core::OptionParams& params) const {
+    const bool use_antithetic = vr_method_ == VarianceReductionMethod::AntitheticVariates;
+    if (vr_method_ != VarianceReductionMethod::None && !use_antithetic) {
+        throw std::invalid_argument(
+            "MCAmericanLSMCEngine: path regeneration supports only None and AntitheticVariates");
+    }
+    DateOneValues values = regeneratedInduction(spec, params, paths_, use_antithetic, nullptr);
+    const std::size_t steps = std::max<std::size_t>(1, time_steps_);
+    return settle(spec, params, std::exp(-params.r * params.T / static_cast<double>(steps)), values);
+}
+
+MCAmericanLSMCEngine::DateOneValues MCAmericanLSMCEngine::regeneratedInduction(
+    const core::OptionSpec& spec, const core::OptionParams& params, std::size_t paths, bool antithetic,
+    ExercisePolicy* policy) const {
+    const std::size_t steps = std::max<std::size_t>(1, time_steps_);
+    double dt = params.T / static_cast<double>(steps);
+    double discount = std::exp(-params.r * dt);
+    double drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
+    double diffusion = params.sig * std::sqrt(dt);
+    double scale = params.K > 1e-12 ? params.K : std::max(params.S, 1.0);
+    double inv_scale = (scale > 1e-12) ? 1.0 / scale : 1.0;
+
+    // w holds W(t_step) / sqrt(dt) (variance `step`). Each task draws every date from
+    // its own Philox substream keyed by (step, task), so the paths do not depend on the
+    // thread count; antithetic pairs share draws with opposite signs.
+    std::vector<double> w(paths);
+    std::vector<double> spots(paths);
+    const std::size_t tasks = (paths + PATHS_PER_TASK - 1) / PATHS_PER_TASK;
+    auto advance = [&](std::size_t step) {
+        // Terminal date: W ~ N(0, steps). Earlier dates: W(k) | W(k + 1) = w is
+        // N(w k / (k + 1), k / (k + 1)).
+        const bool terminal = step == steps;
+        const double shrink = terminal ? 0.0 : static_cast<double>(step) / static_cast<double>(step + 1);
+        const double sd = terminal ? std::sqrt(static_cast<double>(steps)) : std::sqrt(shrink);
+        const double log_drift = std::log(params.S) + drift * static_cast<double>(step);
+        core::parallel_for(tasks, threads_, [&](std::size_t task) {
+            math::random::Philox4x32 rng(seed_, (static_cast<std::uint64_t>(step) << 32) | task);
+            const std::size_t first = task * PATHS_PER_TASK;
+            const std::size_t last = std::min(paths, first + PATHS_PER_TASK);
+            for (std::size_t i = first; i < last; ++i) {
+                if (antithetic && ((i - first) & 1u)) {
+                    w[i] = -w[i - 1];
+                } else {
+                    w[i] = shrink * w[i] + sd * math::random::standard_normal(rng);
+                }
+                spots[i] = std::exp(log_drift + diffusion * w[i]);
             }
-            itm_spots.push_back(spot);
-            itm_cf.push_back(cashflows[path]);
-        }
+        });
+    };
+
+    DateOneValues values;
+    std::vector<double>& cashflows = values.cashflows;
+    cashflows.resize(paths);
+    advance(steps);
+    for (std::size_t i = 0; i < paths; ++i) {
+        cashflows[i] = spec.payoff(spots[i]);
+    }
+    if (control_variate_ && policy == nullptr) {
+        values.control = cashflows;
+    }
 
-        if (itm_spots.empty()) {
-            continue;
+    int degree = std::max(0, polynomial_degree_);
+    LsmcWorkspace ws(paths, degree, regression_method_);
+    const bool with_greeks = path_greeks_ && policy == nullptr;
+    if (with_greeks) {
+        trackStops(ws, spots.data(), paths, steps);
+    }
+    BasisFill fill = basisFill(degree);
+    if (policy != nullptr) {
+        policy->reset(steps, degree, inv_scale);
+    }
+    for (std::size_t step = steps; step-- > 1;) {
+        advance(step);
+        ws.step = step;
+        if (exerciseDate(spec, spots.data(), discount, inv_scale, fill, degree, threads_, cashflows, ws) &&
+            policy != nullptr) {
+            policy->record(step, ws.coefficients.data());
         }
+    }
+    if (with_greeks) {
+        stopGreeks(ws, spec, GbmPathGreeks(params, steps), discount, values.delta, values.vega);
+    }
+    return values;
+}
+
+MCAmericanLSMCEngine::ExercisePolicy MCAmericanLSMCEngine::fitPolicy(const core::OptionSpec& spec,
+                                                                       const core::OptionParams& params) const {
+    if (spec.exercise != core::ExerciseStyle::American) {
+        throw std::invalid_argument("MCAmericanLSMCEngine: American exercise style required");
+    }
+    const bool antithetic = vr_method_ == VarianceReductionMethod::AntitheticVariates ||
+                            vr_method_ == VarianceReductionMethod::AntitheticMomentMatching;
+    ExercisePolicy policy;
+    if (params.T <= 0.0 || params.sig <= 0.0) {
+        policy.reset(std::max<std::size_t>(1, time_steps_), std::max(0, polynomial_degree_), 1.0);
+        return policy;
+    }
+    regeneratedInduction(spec, params, training_paths_ > 0 ? training_paths_ : paths_, antithetic, &policy);
+    return policy;
+}
 
-        auto coefficients = regressContinuation(itm_spots, itm_cf, degree, scale);
+PriceOutputs MCAmericanLSMCEngine::priceOutOfSample(const core::OptionSpec& spec,
+                                                    const core::OptionParams& params,
+                                                    const ExercisePolicy& policy) const {
+    const std::size_t steps = policy.steps;
+    if (steps != std::max<std::size_t>(1, time_steps_) || policy.degree < 0 ||
+        policy.coefficients.size() != (steps + 1) * static_cast<std::size_t>(policy.degree + 1) ||
+        policy.fitted.size() != steps + 1) {
+        throw std::invalid_argument("MCAmericanLSMCEngine: exercise policy does not match the time steps");
+    }
+    std::vector<double> discounts(steps + 1);
+    for (std::size_t step = 0; step <= steps; ++step) {
+        discounts[step] = std::exp(-params.r * params.T * static_cast<double>(step) / static_cast<double>(steps));
+    }
 
-        for (std::size_t path = 0; path < paths_; ++path) {
-            double spot = paths[path][step];
-            double intrinsic = spec.payoff(spot);
-            if (intrinsic <= 0.0) {
-                continue;
+    // Each path stops at the first date the fitted policy exercises; only the
+    // statistics of its discounted cash flow are kept.
+    const GbmPathGreeks greeks(params, steps);
+    const bool with_control = control_variate_ && params.T > 0.0 && params.sig > 0.0;
+    const std::size_t columns = path_greeks_ ? 3 : 1;
+    SampleStats stats = simulateSamples(
+        params, columns,
+        [&](const std::vector<double>& path, double* samples) {
+            std::size_t stop = steps;
+            for (std::size_t step = 1; step < steps; ++step) {
+                if (policy.exercise(step, path[step], spec.payoff(path[step]))) {
+                    stop = step;
+                    break;
+                }
             }
-            double continuation = evaluateContinuation(spot, coefficients, degree, scale);
-            if (intrinsic > continuation) {
-                cashflows[path] = intrinsic;
+            const double spot = path[stop];
+            samples[0] = discounts[stop] * spec.payoff(spot);
+            if (path_greeks_) {
+                double slope = discounts[stop] * spec.payoff.slope(spot);
+                samples[1] = slope * greeks.spotDelta(spot);
+                samples[2] = slope * greeks.spotVega(spot, stop);
             }
-        }
+            if (with_control) {
+                samples[columns] = discounts[steps] * spec.payoff(path[steps]);
+            }
+        },
+        with_control);
+
+    PriceOutputs outputs{};
+    stats.write(outputs, path_greeks_, with_control ? europeanPrice(spec, params) : 0.0);
+    exerciseNow(spec, params, path_greeks_, outputs);
+    return outputs;
+}
+
+MCAmericanLSMCEngine::PriceBounds MCAmericanLSMCEngine::priceBounds(const core::OptionSpec& spec,
+                                                                    const core::OptionParams& params,
+                                                                    std::size_t outer_paths,
+                                                                    std::size_t inner_paths) const {
+    if (spec.exercise != core::ExerciseStyle::American) {
+        throw std::invalid_argument("MCAmericanLSMCEngine: American exercise style required");
+    }
+    if (vr_method_ == VarianceReductionMethod::Multilevel) {
+        throw std::invalid_argument("MCAmericanLSMCEngine: Multilevel Monte Carlo is not supported");
+    }
+    if (outer_paths == 0 || inner_paths == 0) {
+        throw std::invalid_argument("MCAmericanLSMCEngine: dual bound needs outer and inner paths");
     }
 
-    // Discount from first exercise date to t=0
-    for (double& cf : cashflows) {
-        cf *= discount;
+    PriceBounds bounds{};
+    if (params.T <= 0.0 || params.sig <= 0.0 || paths_ == 0) {
+        bounds.lower.value = spec.payoff(params.S);
+        bounds.upper = bounds.lower.value;
+        return bounds;
     }
 
-    double intrinsic_now = spec.payoff(params.S);
-    if (intrinsic_now > 0.0) {
-        for (double& cf : cashflows) {
-            if (intrinsic_now > cf) {
-                cf = intrinsic_now;
+    ExercisePolicy fitted;
+    if (!policy_) {
+        fitted = fitPolicy(spec, params);
+    }
+    const ExercisePolicy& policy = policy_ ? *policy_ : fitted;
+    bounds.lower = priceOutOfSample(spec, params, policy);
+
+    const std::size_t steps = policy.steps;
+    double dt = params.T / static_cast<double>(steps);
+    double drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
+    double diffusion = params.sig * std::sqrt(dt);
+    std::vector<double> discounts(steps + 1);
+    for (std::size_t step = 0; step <= steps; ++step) {
+        discounts[step] = std::exp(-params.r * dt * static_cast<double>(step));
+    }
+    const double intrinsic_now = spec.payoff(params.S);
+
+    // Q(k, spot): discounted value of following the policy from date k + 1 on, by
+    // `inner_paths` nested paths started at `spot`.
+    auto continuation = [&](std::size_t k, double spot, math::random::Philox4x32& rng) {
+        double sum = 0.0;
+        for (std::size_t n = 0; n < inner_paths; ++n) {
+            double s = spot;
+            for (std::size_t step = k + 1; step <= steps; ++step) {
+                s *= std::exp(drift + diffusion * math::random::standard_normal(rng));
+                double intrinsic = spec.payoff(s);
+                if (step == steps || policy.exercise(step, s, intrinsic)) {
+                    sum += discounts[step] * intrinsic;
+                    break;
+                }
             }
         }
+        return sum / static_cast<double>(inner_paths);
+    };
+
+    // Andersen-Broadie: the policy's discounted value process L (h_k where it exercises,
+    // Q_k elsewhere) gives martingale increments L_k - Q_{k-1}, and
+    // E[max_k (h_k - M_k)] bounds the price from above. Outer path o draws from the
+    // substream DUAL_STREAM | o << 24 and its nested paths at date k from that stream
+    // + k + 1, so the estimate is independent of the thread count.
+    std::vector<double> duals(outer_paths);
+    core::parallel_for(outer_paths, threads_, [&](std::size_t o) {
+        const std::uint64_t stream = DUAL_STREAM | (static_cast<std::uint64_t>(o) << 24);
+        math::random::Philox4x32 rng(seed_, stream);
+        auto nested = [&](std::size_t k, double spot) {
+            math::random::Philox4x32 inner(seed_, stream + k + 1);
+            return continuation(k, spot, inner);
+        };
+
+        double spot = params.S;
+        double previous_q = nested(0, spot);
+        double martingale = 0.0;
+        double dual = intrinsic_now;
+        for (std::size_t k = 1; k <= steps; ++k) {
+            spot *= std::exp(drift + diffusion * math::random::standard_normal(rng));
+            double intrinsic = spec.payoff(spot);
+            double exercise_value = discounts[k] * intrinsic;
+            double q = k < steps ? nested(k, spot) : 0.0;
+            bool exercise = k == steps || policy.exercise(k, spot, intrinsic);
+            martingale += (exercise ? exercise_value : q) - previous_q;
+            dual = std::max(dual, exercise_value - martingale);
+            previous_q = q;
+        }
+        duals[o] = dual;
+    });
+
+    bounds.upper = math::stats::mean(duals);
+    bounds.upper_std_error = math::stats::standard_error(duals);
+    return bounds;
+}
+
+double MCAmericanLSMCEngine::europeanPrice(const core::OptionSpec& spec, const core::OptionParams& params) {
+    core::OptionSpec european{spec.payoff, core::ExerciseStyle::European};
+    core::OptionParams european_params = params;
+    european_params.K = spec.payoff.strike;
+    return BSEuropeanAnalytic().price(european, european_params).value;
+}
+
+void MCAmericanLSMCEngine::exerciseNow(const core::OptionSpec& spec, const core::OptionParams& params,
+                                       bool greeks, PriceOutputs& outputs) {
+    double intrinsic_now = spec.payoff(params.S);
+    if (intrinsic_now > outputs.value) {
+        outputs = PriceOutputs{};
+        outputs.value = intrinsic_now;
+        outputs.delta = greeks ? spec.payoff.slope(params.S) : 0.0;
+    }
+}
+
+PriceOutputs MCAmericanLSMCEngine::settle(const core::OptionSpec& spec, const core::OptionParams& params,
+                                          double discount, DateOneValues& values) const {
+    std::vector<double>& cashflows = values.cashflows;
+    const bool with_greeks = !values.delta.empty();
+    // Discount from first exercise date to t=0
+    for (std::size_t i = 0; i < cashflows.size(); ++i) {
+        cashflows[i] *= discount;
+        if (with_greeks) {
+            values.delta[i] *= discount;
+            values.vega[i] *= discount;
+        }
     }
 
-    applyVarianceReduction(cashflows, spec, params);
+    const bool with_control = !values.control.empty();
+    const std::size_t columns = with_greeks ? 3 : 1;
+    const double control_discount = std::exp(-params.r * params.T);
+    SampleStats stats(*this, columns, with_control);
+    double samples[4] = {0.0, 0.0, 0.0, 0.0};
+    for (std::size_t i = 0; i < cashflows.size(); ++i) {
+        samples[0] = cashflows[i];
+        if (with_greeks) {
+            samples[1] = values.delta[i];
+            samples[2] = values.vega[i];
+        }
+        if (with_control) {
+            samples[columns] = control_discount * values.control[i];
+        }
+        stats.add(i, samples);
+    }
 
     PriceOutputs outputs{};
-    outputs.value = math::stats::mean(cashflows);
-    outputs.std_dev = math::stats::standard_deviation(cashflows);
-    outputs.std_error = math::stats::standard_error(cashflows);
+    stats.write(outputs, with_greeks, with_control ? europeanPrice(spec, params) : 0.0);
+    exerciseNow(spec, params, with_greeks, outputs);
     return outputs;
 }
 
@@ -1,15 +1,80 @@
 #pragma once
 
 #include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include "engines/MCEngine.hpp"
+#include "math/LeastSquares.hpp"
 
 namespace engines {
 
 // Longstaff-Schwartz Monte Carlo engine for American vanilla options.
 class MCAmericanLSMCEngine : public BaseMCEngine {
+   public:
+    using RegressionMethod = math::lsq::Method;
+
+    // Storage of the simulated spots; Float halves the memory of the path set, with
+    // spots rounded to ~1e-7 relative before regression and payoff.
+    enum class PathPrecision { Double, Float };
+
+    // Exercise rule of one contract: the continuation regression of every exercise date,
+    // with x = spot * inv_scale fed to a Laguerre basis of `degree`. Plain data, so it can
+    // be stored and handed to another engine with the same number of time steps.
+    struct ExercisePolicy {
+        std::size_t steps{0};
+        int degree{0};
+        double inv_scale{1.0};
+        std::vector<double> coefficients;   // degree + 1 per date, date-major
+        std::vector<unsigned char> fitted;  // per date; unfitted dates never exercise
+
+        void reset(std::size_t dates, int basis_degree, double scale);
+        void record(std::size_t step, const double* beta);
+        // True where the intrinsic value beats the fitted continuation.
+        bool exercise(std::size_t step, double spot, double intrinsic) const;
+    };
+
    private:
     int polynomial_degree_;
+    RegressionMethod regression_method_ = RegressionMethod::Cholesky;
+    PathPrecision path_precision_ = PathPrecision::Double;
+    bool regenerate_paths_ = false;
+    std::size_t training_paths_ = 0;
+
+    std::optional<ExercisePolicy> policy_;
+
+    // Each path's cash flow discounted to the first exercise date and, with path Greeks
+    // on, its pathwise delta and vega (empty otherwise). With the control variate on,
+    // `control` holds each path's undiscounted European payoff at expiry.
+    struct DateOneValues {
+        std::vector<double> cashflows;
+        std::vector<double> delta;
+        std::vector<double> vega;
+        std::vector<double> control;
+    };
+
+    // Exact price of the control: the European option with the same payoff.
+    static double europeanPrice(const core::OptionSpec& spec, const core::OptionParams& params);
+    // Exercises at t=0 when intrinsic value beats the estimated continuation value in
+    // `outputs`: a policy decision on the estimate, not a per-path floor.
+    static void exerciseNow(const core::OptionSpec& spec, const core::OptionParams& params, bool greeks,
+                            PriceOutputs& outputs);
+
+    template <typename Real>
+    PriceOutputs priceOnPaths(const core::OptionSpec& spec, const core::OptionParams& params,
+                              const TimeMajorPaths<Real>& paths) const;
+    PriceOutputs priceRegenerated(const core::OptionSpec& spec, const core::OptionParams& params) const;
+    // Backward induction on `paths` regenerated paths. When `policy` is given it records
+    // every date's coefficients there (and skips the path Greeks).
+    DateOneValues regeneratedInduction(const core::OptionSpec& spec, const core::OptionParams& params,
+                                       std::size_t paths, bool antithetic, ExercisePolicy* policy) const;
+    PriceOutputs priceOutOfSample(const core::OptionSpec& spec, const core::OptionParams& params,
+                                  const ExercisePolicy& policy) const;
+    // Discounts the date-1 cashflows to t=0, reduces them to the price statistics and
+    // compares the estimate with immediate exercise.
+    PriceOutputs settle(const core::OptionSpec& spec, const core::OptionParams& params, double discount,
+                        DateOneValues& values) const;
 
    public:
     explicit MCAmericanLSMCEngine(std::size_t paths = 10000,
@@ -22,6 +87,63 @@ class MCAmericanLSMCEngine : public BaseMCEngine {
     PriceOutputs price(const core::OptionSpec& spec, const core::OptionParams& params) const override;
     void setPolynomialDegree(int degree) { polynomial_degree_ = degree; }
     int getPolynomialDegree() const { return polynomial_degree_; }
+
+    // Solver for the continuation regressions. Every method escalates (Cholesky to QR to
+    // truncated SVD) when the basis is too ill-conditioned for it, so high degrees still
+    // get a least-squares fit. The normal equations are summed on getThreadCount() threads.
+    void setRegressionMethod(RegressionMethod method) { regression_method_ = method; }
+    RegressionMethod getRegressionMethod() const { return regression_method_; }
+
+    // Paths are stored time-major, so each exercise date reads one contiguous row. The
+    // simulation and every exercise date (gathering, basis, normal equations and the
+    // exercise decision) run on getThreadCount() threads, with results independent of
+    // the thread count.
+    void setPathPrecision(PathPrecision precision) { path_precision_ = precision; }
+    PathPrecision getPathPrecision() const { return path_precision_; }
+
+    // Low-memory mode: no path set is stored. Each path draws its terminal Brownian value
+    // and the induction walks back one date at a time by sampling the Brownian bridge
+    // W(t_k - dt) | W(t_k), so only the current row is held and peak memory is O(paths)
+    // rather than O(paths * steps). Supports None and AntitheticVariates; the paths are
+    // a different (equally distributed) sample from the stored mode's.
+    void setPathRegeneration(bool enabled) { regenerate_paths_ = enabled; }
+    bool getPathRegeneration() const { return regenerate_paths_; }
+
+    // Two-phase pricing. With training_paths > 0, price() fits the exercise boundary on
+    // that many regenerated paths, then streams paths_ independent paths through it (any
+    // variance reduction but Multilevel). Each path's discounted cash flow goes into
+    // per-block statistics and nothing is stored per path. The fit's look-ahead bias
+    // is gone, so the price is a low-biased estimate. 0 (the default) fits and prices
+    // on the same paths.
+    void setTrainingPaths(std::size_t paths) { training_paths_ = paths; }
+    std::size_t getTrainingPaths() const { return training_paths_; }
+
+    struct PriceBounds {
+        PriceOutputs lower;  // out-of-sample price of the fitted policy
+        double upper{0.0};   // Andersen-Broadie dual estimate
+        double upper_std_error{0.0};
+    };
+
+    // Lower and upper bound on the price. The boundary is fitted on getTrainingPaths()
+    // paths (paths_ when 0) and priced out of sample as above. The upper bound is the
+    // Andersen-Broadie dual: `outer_paths` paths, with the policy's continuation value at
+    // every date estimated from `inner_paths` nested paths, spread over getThreadCount()
+    // threads. The cost is about outer * inner * steps^2 / 2 path steps.
+    PriceBounds priceBounds(const core::OptionSpec& spec, const core::OptionParams& params,
+                            std::size_t outer_paths, std::size_t inner_paths) const;
+
+    // Runs the backward induction alone (on getTrainingPaths() regenerated paths, paths_
+    // when 0) and returns the fitted policy.
+    ExercisePolicy fitPolicy(const core::OptionSpec& spec, const core::OptionParams& params) const;
+
+    // With a policy set, price() and priceBounds() skip the regressions: price() is a
+    // single forward pass of paths_ paths stopped by the policy. Meant for repricing the
+    // same contract after small moves in spot or vol, and for bumped Greeks, where a
+    // shared policy and seed keep the bumps smooth. The policy is indexed by exercise
+    // date, so its steps must equal the engine's time steps.
+    void setExercisePolicy(ExercisePolicy policy) { policy_ = std::move(policy); }
+    void clearExercisePolicy() { policy_.reset(); }
+    const std::optional<ExercisePolicy>& getExercisePolicy() const { return policy_; }
     std::size_t getTimeSteps() const { return time_steps_; }
 
 };  // class MCAmericanLSMCEngine
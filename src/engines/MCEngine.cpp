@@ -2,139 +2,878 @@
 
 #include <algorithm>
 #include <cmath>
-#include <random>
+#include <stdexcept>
+
+#include "core/Parallel.hpp"
+#include "core/Simd.hpp"
+#include "math/BrownianBridge.hpp"
+#include "math/FastMath.hpp"
+#include "math/Normal.hpp"
+#include "math/Random.hpp"
+#include "math/Sobol.hpp"
+#include "math/Stats.hpp"
 
 namespace engines {
 
-std::vector<std::vector<double>> BaseMCEngine::generatePaths(const core::OptionParams& params) const {
-    std::size_t steps = std::max<std::size_t>(1, time_steps_);
-    std::vector<std::vector<double>> paths(paths_, std::vector<double>(steps + 1, params.S));
+namespace {
+
+// Paths are simulated in fixed blocks, each drawing from its own Philox substream
+// keyed by (seed, block index). Results therefore depend only on the seed, never on
+// how blocks are spread across threads. Even size keeps antithetic pairs in one block.
+constexpr std::size_t PATH_BLOCK_SIZE = 1024;
+
+// Multilevel samples are drawn in smaller blocks: fine levels need few paths.
+constexpr std::size_t MLMC_BLOCK_SIZE = 64;
+
+struct LevelSums {
+    double sum{0.0};
+    double sum_sq{0.0};
+};
+
+// Base paths of a block simulated together. Their normals come from one batch of
+// Philox words, and every step advances all of them at once, so the draws, the
+// log-spot updates and the exponentials vectorise across paths. Loops run over all
+// PATH_LANES lanes (like BS batch chunks, without runtime checks or a scalar
+// remainder); a block's last chunk simulates a few lanes nobody visits.
+constexpr std::size_t PATH_LANES = 64;
+
+struct PathChunk {
+    std::uint64_t seed;
+    std::uint64_t stream;
+    std::uint64_t first_counter;  // Philox counter of the chunk's first word
+    std::size_t steps;
+    double log_spot;
+    double drift;
+    double diffusion;
+    double noise_mean;  // moment matching; 0 and 1 otherwise
+    double noise_inv_sd;
+    std::uint32_t* words;  // steps * PATH_LANES each, step-major
+    double* z;
+    double* spots;   // null to draw z only
+    double* mirror;  // antithetic twins, or null
+};
+
+// Spots along each lane from the chunk's normals, scaled by `sign`: running sums of
+// the log increments, then a pass of exponentials.
+MATH_FAST_INLINE void accumulateLogSpots(const PathChunk& c, double sign, double* spots) {
+    for (std::size_t l = 0; l < PATH_LANES; ++l) {
+        spots[l] = c.log_spot;
+    }
+    const double* previous = spots;
+    for (std::size_t step = 0; step < c.steps; ++step) {
+        const double* z = c.z + step * PATH_LANES;
+        double* current = spots + step * PATH_LANES;
+        for (std::size_t l = 0; l < PATH_LANES; ++l) {
+            current[l] = previous[l] + c.drift + sign * c.diffusion * ((z[l] - c.noise_mean) * c.noise_inv_sd);
+        }
+        previous = current;
+    }
+    for (std::size_t step = 0; step < c.steps; ++step) {
+        double* current = spots + step * PATH_LANES;
+        for (std::size_t l = 0; l < PATH_LANES; ++l) {
+            current[l] = math::fast::exp(current[l]);
+        }
+    }
+}
+
+// z[step * PATH_LANES + lane] by inverting the uniforms (w + 1/2) 2^-32, so |z| < 6.3;
+// then, unless spots is null, the spots of every lane.
+MATH_FAST_INLINE void simulateChunk(const PathChunk& c) {
+    math::random::Philox4x32::fill(c.seed, c.stream, c.first_counter, c.steps * PATH_LANES / 4, c.words);
+    for (std::size_t step = 0; step < c.steps; ++step) {
+        const std::uint32_t* w = c.words + step * PATH_LANES;
+        double* z = c.z + step * PATH_LANES;
+        for (std::size_t l = 0; l < PATH_LANES; ++l) {
+            // Signed conversion: there is no unsigned 32-bit to double below AVX-512.
+            auto centred = static_cast<std::int32_t>(w[l] ^ 0x80000000u);
+            double u = (static_cast<double>(centred) + 2147483648.5) * 0x1p-32;
+            z[l] = math::fast::N_inv(u);
+        }
+    }
+    if (c.spots == nullptr) {
+        return;
+    }
+
+    accumulateLogSpots(c, 1.0, c.spots);
+    if (c.mirror != nullptr) {
+        accumulateLogSpots(c, -1.0, c.mirror);
+    }
+}
+
+using ChunkKernel = void (*)(const PathChunk& c);
+
+#ifdef CORE_SIMD_X86_DISPATCH
+__attribute__((target("avx512f,avx512dq,fma"))) void simulateChunkAvx512(const PathChunk& c) {
+    simulateChunk(c);
+}
 
+__attribute__((target("avx2,fma"))) void simulateChunkAvx2(const PathChunk& c) {
+    simulateChunk(c);
+}
+#endif
+
+void simulateChunkBaseline(const PathChunk& c) {
+    simulateChunk(c);
+}
+
+ChunkKernel chunkKernel() {
+#ifdef CORE_SIMD_X86_DISPATCH
+    switch (core::detect_simd_level()) {
+        case core::SimdLevel::AVX512:
+            return simulateChunkAvx512;
+        case core::SimdLevel::AVX2:
+            return simulateChunkAvx2;
+        case core::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    return simulateChunkBaseline;
+}
+
+// Block and chunk layout of a run. Antithetic runs simulate the first half of each
+// block's paths and mirror them, so a pair never straddles two blocks.
+struct BlockLayout {
+    std::size_t paths;
+    bool antithetic;
+
+    std::size_t blocks() const { return (paths + PATH_BLOCK_SIZE - 1) / PATH_BLOCK_SIZE; }
+    std::size_t blockPaths(std::size_t block) const {
+        return std::min(PATH_BLOCK_SIZE, paths - block * PATH_BLOCK_SIZE);
+    }
+    std::size_t basePaths(std::size_t block) const {
+        return antithetic ? (blockPaths(block) + 1) / 2 : blockPaths(block);
+    }
+    std::size_t chunks(std::size_t block) const { return (basePaths(block) + PATH_LANES - 1) / PATH_LANES; }
+    std::size_t lanes(std::size_t block, std::size_t chunk) const {
+        return std::min(PATH_LANES, basePaths(block) - chunk * PATH_LANES);
+    }
+};
+
+// `proto` placed at chunk `chunk` of block `block`. Each block draws from its own
+// substream and its chunk c starts at counter c * PATH_LANES * steps / 4, so the draws
+// of a block are fixed by the seed.
+PathChunk chunkAt(PathChunk proto, std::size_t block, std::size_t chunk, std::vector<std::uint32_t>& words,
+                  std::vector<double>& z) {
+    proto.stream = block;
+    proto.first_counter = chunk * PATH_LANES * proto.steps / 4;
+    words.resize(PATH_LANES * proto.steps);
+    z.resize(PATH_LANES * proto.steps);
+    proto.words = words.data();
+    proto.z = z.data();
+    return proto;
+}
+
+// Moment matching: a pre-pass over every block's draws sets proto's noise mean and
+// inverse standard deviation to the run's sample moments. The main pass then replays
+// the same substreams.
+void matchNoiseMoments(PathChunk& proto, const BlockLayout& layout, std::size_t threads, ChunkKernel kernel) {
+    std::vector<math::stats::RunningStats> partial(layout.blocks());
+    core::parallel_for(layout.blocks(), threads, [&](std::size_t block) {
+        std::vector<std::uint32_t> words;
+        std::vector<double> z;
+        for (std::size_t chunk = 0; chunk < layout.chunks(block); ++chunk) {
+            kernel(chunkAt(proto, block, chunk, words, z));
+            const std::size_t lanes = layout.lanes(block, chunk);
+            for (std::size_t step = 0; step < proto.steps; ++step) {
+                partial[block].add(z.data() + step * PATH_LANES, lanes);
+            }
+        }
+    });
+    math::stats::RunningStats total;
+    for (const auto& m : partial) {
+        total.add(m);
+    }
+    double sd = (total.count() > 0) ? std::sqrt(total.m2() / static_cast<double>(total.count())) : 0.0;
+    proto.noise_mean = total.mean();
+    proto.noise_inv_sd = (sd > 0.0) ? 1.0 / sd : 1.0;
+}
+
+}  // namespace
+
+void BaseMCEngine::simulatePaths(const core::OptionParams& params, const PathVisitor& visit) const {
+    std::size_t steps = std::max<std::size_t>(1, time_steps_);
     if (paths_ == 0) {
-        return paths;
+        return;
     }
 
     if (params.T <= 0.0 || params.sig <= 0.0) {
-        for (auto& path : paths) {
-            std::fill(path.begin(), path.end(), params.S);
+        std::vector<double> path(steps + 1, params.S);
+        for (std::size_t i = 0; i < paths_; ++i) {
+            visit(i, path);
         }
-        return paths;
+        return;
+    }
+
+    if (vr_method_ == VarianceReductionMethod::QuasiMonteCarlo) {
+        simulateSobolPaths(params, visit);
+        return;
     }
 
     double dt = params.T / static_cast<double>(steps);
-    double drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
-    double diffusion = params.sig * std::sqrt(dt);
+    const bool use_antithetic = vr_method_ == VarianceReductionMethod::AntitheticVariates ||
+                                vr_method_ == VarianceReductionMethod::AntitheticMomentMatching;
+    const bool use_moment = vr_method_ == VarianceReductionMethod::MomentMatching ||
+                            vr_method_ == VarianceReductionMethod::AntitheticMomentMatching;
 
-    std::mt19937_64 rng(seed_);
-    std::normal_distribution<double> dist(0.0, 1.0);
+    static const ChunkKernel kernel = chunkKernel();
+    const BlockLayout layout{paths_, use_antithetic};
+    PathChunk proto{};
+    proto.seed = seed_;
+    proto.steps = steps;
+    proto.log_spot = std::log(params.S);
+    proto.drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
+    proto.diffusion = params.sig * std::sqrt(dt);
+    proto.noise_mean = 0.0;
+    proto.noise_inv_sd = 1.0;
+    if (use_moment) {
+        matchNoiseMoments(proto, layout, threads_, kernel);
+    }
+
+    core::parallel_for(layout.blocks(), threads_, [&](std::size_t block) {
+        std::vector<std::uint32_t> words;
+        std::vector<double> z;
+        std::vector<double> spots(PATH_LANES * steps);
+        std::vector<double> mirror(use_antithetic ? PATH_LANES * steps : 0);
+        std::vector<double> path(steps + 1, params.S);
+
+        const std::size_t first = block * PATH_BLOCK_SIZE;
+        const std::size_t last = first + layout.blockPaths(block);
+        for (std::size_t chunk = 0; chunk < layout.chunks(block); ++chunk) {
+            PathChunk c = chunkAt(proto, block, chunk, words, z);
+            c.spots = spots.data();
+            c.mirror = use_antithetic ? mirror.data() : nullptr;
+            kernel(c);
+
+            // Hand each path to the visitor in path order; antithetic pairs are (i, i + 1).
+            const std::size_t lanes = layout.lanes(block, chunk);
+            for (std::size_t l = 0; l < lanes; ++l) {
+                std::size_t base = chunk * PATH_LANES + l;
+                std::size_t i = first + (use_antithetic ? 2 * base : base);
+                for (std::size_t step = 0; step < steps; ++step) {
+                    path[step + 1] = spots[step * PATH_LANES + l];
+                }
+                visit(i, path);
+                if (use_antithetic && i + 1 < last) {
+                    for (std::size_t step = 0; step < steps; ++step) {
+                        path[step + 1] = mirror[step * PATH_LANES + l];
+                    }
+                    visit(i + 1, path);
+                }
+            }
+        }
+    });
+}
+
+PriceOutputs BaseMCEngine::priceTerminal(const core::PlainVanillaPayoff& payoff,
+                                         const core::OptionParams& params) const {
+    PriceOutputs outputs{};
+    if (paths_ == 0) {
+        return outputs;
+    }
 
     const bool use_antithetic = vr_method_ == VarianceReductionMethod::AntitheticVariates ||
                                 vr_method_ == VarianceReductionMethod::AntitheticMomentMatching;
     const bool use_moment = vr_method_ == VarianceReductionMethod::MomentMatching ||
                             vr_method_ == VarianceReductionMethod::AntitheticMomentMatching;
 
-    if (use_antithetic && !use_moment) {
-        for (std::size_t i = 0; i < paths_; i += 2) {
-            double spot_plus = params.S;
-            double spot_minus = params.S;
-            for (std::size_t step = 1; step <= steps; ++step) {
-                double z = dist(rng);
-                spot_plus *= std::exp(drift + diffusion * z);
-                paths[i][step] = spot_plus;
-                if (i + 1 < paths_) {
-                    spot_minus *= std::exp(drift - diffusion * z);
-                    paths[i + 1][step] = spot_minus;
+    // One step of length T: the chunk kernel's single row of spots is S_T.
+    static const ChunkKernel kernel = chunkKernel();
+    const BlockLayout layout{paths_, use_antithetic};
+    PathChunk proto{};
+    proto.seed = seed_;
+    proto.steps = 1;
+    proto.log_spot = std::log(params.S);
+    proto.drift = (params.r - params.q - 0.5 * params.sig * params.sig) * params.T;
+    proto.diffusion = params.sig * std::sqrt(params.T);
+    proto.noise_mean = 0.0;
+    proto.noise_inv_sd = 1.0;
+    if (use_moment) {
+        matchNoiseMoments(proto, layout, threads_, kernel);
+    }
+
+    const double discount = std::exp(-params.r * params.T);
+    const GbmPathGreeks greeks(params, 1);
+    struct Lanes {
+        double value[PATH_LANES];
+        double delta[PATH_LANES];
+        double vega[PATH_LANES];
+        double control[PATH_LANES];  // discounted S_T, of mean S e^{-qT}
+    };
+    auto evaluate = [&](const double* spots, Lanes& out) {
+        for (std::size_t l = 0; l < PATH_LANES; ++l) {
+            out.value[l] = discount * payoff(spots[l]);
+        }
+        if (control_variate_) {
+            for (std::size_t l = 0; l < PATH_LANES; ++l) {
+                out.control[l] = discount * spots[l];
+            }
+        }
+        if (path_greeks_) {
+            for (std::size_t l = 0; l < PATH_LANES; ++l) {
+                double slope = discount * payoff.slope(spots[l]);
+                out.delta[l] = slope * greeks.spotDelta(spots[l]);
+                out.vega[l] = slope * greeks.spotVega(spots[l], 1);
+            }
+        }
+    };
+
+    struct TerminalMoments {
+        math::stats::RunningStats value;
+        math::stats::RunningStats delta;
+        math::stats::RunningStats vega;
+        math::stats::RunningCovariance value_control;
+    };
+    std::vector<TerminalMoments> partial(layout.blocks());
+    core::parallel_for(layout.blocks(), threads_, [&](std::size_t block) {
+        std::vector<std::uint32_t> words;
+        std::vector<double> z;
+        double spots[PATH_LANES];
+        double mirror[PATH_LANES];
+        Lanes base;
+        Lanes twin;
+        TerminalMoments& moments = partial[block];
+        for (std::size_t chunk = 0; chunk < layout.chunks(block); ++chunk) {
+            PathChunk c = chunkAt(proto, block, chunk, words, z);
+            c.spots = spots;
+            c.mirror = use_antithetic ? mirror : nullptr;
+            kernel(c);
+
+            evaluate(spots, base);
+            const std::size_t lanes = layout.lanes(block, chunk);
+            if (use_antithetic) {
+                // Each sample is a pair's mean; an odd block's last path has no twin.
+                evaluate(mirror, twin);
+                std::size_t paired = lanes;
+                if (2 * (chunk * PATH_LANES + lanes) > layout.blockPaths(block)) {
+                    --paired;
+                }
+                for (std::size_t l = 0; l < paired; ++l) {
+                    base.value[l] = 0.5 * (base.value[l] + twin.value[l]);
                 }
+                for (std::size_t l = 0; path_greeks_ && l < paired; ++l) {
+                    base.delta[l] = 0.5 * (base.delta[l] + twin.delta[l]);
+                    base.vega[l] = 0.5 * (base.vega[l] + twin.vega[l]);
+                }
+                for (std::size_t l = 0; control_variate_ && l < paired; ++l) {
+                    base.control[l] = 0.5 * (base.control[l] + twin.control[l]);
+                }
+            }
+            moments.value.add(base.value, lanes);
+            if (control_variate_) {
+                moments.value_control.add(base.value, base.control, lanes);
             }
-            if (i + 1 >= paths_) {
-                break;
+            if (path_greeks_) {
+                moments.delta.add(base.delta, lanes);
+                moments.vega.add(base.vega, lanes);
             }
         }
+    });
+
+    TerminalMoments total;
+    for (const auto& m : partial) {
+        total.value.add(m.value);
+        total.delta.add(m.delta);
+        total.vega.add(m.vega);
+        total.value_control.add(m.value_control);
+    }
+    if (control_variate_) {
+        math::stats::ControlVariateEstimate estimate =
+            total.value_control.control_variate(params.S * std::exp(-params.q * params.T));
+        outputs.value = estimate.value;
+        outputs.std_dev = estimate.std_dev;
+        outputs.std_error = estimate.std_error;
     } else {
-        std::vector<double> noises;
-        if (use_moment) {
-            std::size_t base_paths = use_antithetic ? (paths_ + 1) / 2 : paths_;
-            noises.resize(base_paths * steps);
-            for (double& z : noises) {
-                z = dist(rng);
-            }
-            double mean = 0.0;
-            for (double z : noises) {
-                mean += z;
-            }
-            mean /= noises.size();
-            double var = 0.0;
-            for (double z : noises) {
-                double centered = z - mean;
-                var += centered * centered;
-            }
-            var = std::sqrt(var / noises.size());
-            double inv = (var > 0.0) ? 1.0 / var : 1.0;
-            for (double& z : noises) {
-                z = (z - mean) * inv;
-            }
-        }
-
-        std::size_t noise_idx = 0;
-        auto next_noise = [&]() -> double {
-            if (use_moment) {
-                return noises[noise_idx++];
-            }
-            return dist(rng);
-        };
-
-        if (use_antithetic) {
-            for (std::size_t i = 0; i < paths_; i += 2) {
-                double spot_plus = params.S;
-                double spot_minus = params.S;
-                for (std::size_t step = 1; step <= steps; ++step) {
-                    double z = next_noise();
-                    spot_plus *= std::exp(drift + diffusion * z);
-                    paths[i][step] = spot_plus;
-                    if (i + 1 < paths_) {
-                        spot_minus *= std::exp(drift - diffusion * z);
-                        paths[i + 1][step] = spot_minus;
+        outputs.value = total.value.mean();
+        outputs.std_dev = total.value.standard_deviation();
+        outputs.std_error = total.value.standard_error();
+    }
+    if (path_greeks_) {
+        outputs.delta = total.delta.mean();
+        outputs.delta_std_error = total.delta.standard_error();
+        outputs.vega = total.vega.mean();
+        outputs.vega_std_error = total.vega.standard_error();
+    }
+    return outputs;
+}
+
+std::size_t BaseMCEngine::qmcReplicates() const {
+    if (!qmc_scramble_) {
+        return 1;
+    }
+    return std::max<std::size_t>(1, std::min(qmc_replicates_, paths_));
+}
+
+void BaseMCEngine::simulateSobolPaths(const core::OptionParams& params, const PathVisitor& visit) const {
+    std::size_t steps = std::max<std::size_t>(1, time_steps_);
+    if (steps > math::qmc::SobolSequence::MAX_DIMENSION) {
+        throw std::invalid_argument("QuasiMonteCarlo supports at most 3667 time steps");
+    }
+
+    double dt = params.T / static_cast<double>(steps);
+    double drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
+    double diffusion = params.sig * std::sqrt(dt);
+
+    // Replicate r owns paths [r * paths_ / R, (r + 1) * paths_ / R) and points 0.. of
+    // its own scrambled sequence; the bridge puts the coarse path shape on the
+    // leading, best-distributed Sobol coordinates.
+    const std::size_t replicates = qmcReplicates();
+    auto replicate_begin = [&](std::size_t r) { return r * paths_ / replicates; };
+    auto make_sequence = [&](std::size_t r) {
+        if (!qmc_scramble_) {
+            return math::qmc::SobolSequence(steps);
+        }
+        math::random::Philox4x32 hash(seed_, r);
+        std::uint64_t scramble_seed = (static_cast<std::uint64_t>(hash()) << 32) | hash();
+        return math::qmc::SobolSequence(steps, scramble_seed);
+    };
+
+    const math::BrownianBridge bridge(steps);
+    const std::size_t blocks = (paths_ + PATH_BLOCK_SIZE - 1) / PATH_BLOCK_SIZE;
+
+    core::parallel_for(blocks, threads_, [&](std::size_t block) {
+        const std::size_t first = block * PATH_BLOCK_SIZE;
+        const std::size_t last = std::min(paths_, first + PATH_BLOCK_SIZE);
+
+        std::size_t r = first * replicates / paths_;
+        while (r + 1 < replicates && replicate_begin(r + 1) <= first) {
+            ++r;
+        }
+        while (replicate_begin(r) > first) {
+            --r;
+        }
+        auto sequence = make_sequence(r);
+        sequence.seek(first - replicate_begin(r));
+
+        std::vector<double> normals(steps);
+        std::vector<double> w(steps);
+        std::vector<double> path(steps + 1, params.S);
+        for (std::size_t i = first; i < last; ++i) {
+            if (r + 1 < replicates && i == replicate_begin(r + 1)) {
+                sequence = make_sequence(++r);
+            }
+            sequence.next(normals.data());
+            for (double& x : normals) {
+                x = math::normal::N_inv(x);
+            }
+            bridge.transform(normals.data(), w.data());
+            for (std::size_t step = 1; step <= steps; ++step) {
+                path[step] = params.S * std::exp(drift * static_cast<double>(step) + diffusion * w[step - 1]);
+            }
+            visit(i, path);
+        }
+    });
+}
+
+PriceOutputs BaseMCEngine::priceMultilevel(const core::OptionParams& params, const PathPayoff& payoff) const {
+    const std::size_t base_steps = std::max<std::size_t>(1, time_steps_);
+    const double discount = std::exp(-params.r * params.T);
+
+    PriceOutputs outputs{};
+    if (params.T <= 0.0 || params.sig <= 0.0) {
+        std::vector<double> flat(base_steps + 1, params.S);
+        outputs.value = discount * payoff(flat);
+        return outputs;
+    }
+    if (mlmc_target_rmse_ <= 0.0) {
+        throw std::invalid_argument("Multilevel Monte Carlo requires a positive target RMSE");
+    }
+
+    // Draws `count` samples of Y_l = P_l - P_{l-1} (Y_0 = P_0), starting at sample
+    // `first` of the level. Both are multiples of the block size, and each block has
+    // its own substream keyed by (level, block), so sums are thread-count independent.
+    auto sample_level = [&](std::size_t level, std::size_t first, std::size_t count) {
+        const std::size_t fine_steps = base_steps << level;
+        const double dt = params.T / static_cast<double>(fine_steps);
+        const double drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
+        const double diffusion = params.sig * std::sqrt(dt);
+        const std::size_t first_block = first / MLMC_BLOCK_SIZE;
+        const std::size_t blocks = count / MLMC_BLOCK_SIZE;
+
+        std::vector<LevelSums> partial(blocks);
+        core::parallel_for(blocks, threads_, [&](std::size_t k) {
+            const std::uint64_t stream = (static_cast<std::uint64_t>(level) << 48) | (first_block + k);
+            math::random::Philox4x32 rng(seed_, stream);
+            std::vector<double> fine(fine_steps + 1, params.S);
+            std::vector<double> coarse(fine_steps / 2 + 1, params.S);
+            LevelSums& sums = partial[k];
+            for (std::size_t s = 0; s < MLMC_BLOCK_SIZE; ++s) {
+                double z_prev = 0.0;
+                for (std::size_t j = 1; j <= fine_steps; ++j) {
+                    double z = math::random::standard_normal(rng);
+                    fine[j] = fine[j - 1] * std::exp(drift + diffusion * z);
+                    if (level > 0) {
+                        if (j % 2 == 1) {
+                            z_prev = z;
+                        } else {
+                            coarse[j / 2] = coarse[j / 2 - 1] * std::exp(2.0 * drift + diffusion * (z_prev + z));
+                        }
                     }
                 }
-                if (i + 1 >= paths_) {
-                    break;
+                double y = payoff(fine);
+                if (level > 0) {
+                    y -= payoff(coarse);
                 }
+                y *= discount;
+                sums.sum += y;
+                sums.sum_sq += y * y;
             }
-        } else {
-            for (std::size_t i = 0; i < paths_; ++i) {
-                double spot = params.S;
-                for (std::size_t step = 1; step <= steps; ++step) {
-                    double z = next_noise();
-                    spot *= std::exp(drift + diffusion * z);
-                    paths[i][step] = spot;
-                }
+        });
+
+        LevelSums total;
+        for (const auto& p : partial) {
+            total.sum += p.sum;
+            total.sum_sq += p.sum_sq;
+        }
+        return total;
+    };
+
+    auto round_up = [](double n) {
+        std::size_t blocks = static_cast<std::size_t>(std::ceil(n / static_cast<double>(MLMC_BLOCK_SIZE)));
+        return blocks * MLMC_BLOCK_SIZE;
+    };
+
+    // Giles' adaptive algorithm: theta splits the MSE between sampling variance and
+    // squared bias; alpha/beta are the weak/variance decay rates fitted on the fly.
+    const double theta = 0.5;
+    const double eps2 = mlmc_target_rmse_ * mlmc_target_rmse_;
+    std::size_t L = std::min<std::size_t>(2, mlmc_max_level_);
+    std::vector<std::size_t> n_l(L + 1, 0);
+    std::vector<std::size_t> dn_l(L + 1, round_up(static_cast<double>(mlmc_pilot_paths_)));
+    std::vector<LevelSums> sums(L + 1);
+    std::vector<double> m_l(L + 1, 0.0);
+    std::vector<double> v_l(L + 1, 0.0);
+    double alpha = 1.0;
+    double beta = 1.0;
+
+    auto level_cost = [&](std::size_t l) {
+        double fine = static_cast<double>(base_steps << l);
+        return l == 0 ? fine : 1.5 * fine;
+    };
+    auto optimal_samples = [&]() {
+        double total = 0.0;
+        for (std::size_t l = 0; l <= L; ++l) {
+            total += std::sqrt(v_l[l] * level_cost(l));
+        }
+        for (std::size_t l = 0; l <= L; ++l) {
+            double target = std::sqrt(v_l[l] / level_cost(l)) * total / ((1.0 - theta) * eps2);
+            std::size_t wanted = round_up(target);
+            dn_l[l] = wanted > n_l[l] ? wanted - n_l[l] : 0;
+        }
+    };
+    // Least-squares slope of log2(x_l) against l over levels 1..L.
+    auto decay_rate = [&](const std::vector<double>& x) {
+        double sl = 0.0, sy = 0.0, sll = 0.0, sly = 0.0, n = 0.0;
+        for (std::size_t l = 1; l <= L; ++l) {
+            if (x[l] <= 0.0) {
+                continue;
+            }
+            double y = std::log2(x[l]);
+            double lv = static_cast<double>(l);
+            sl += lv;
+            sy += y;
+            sll += lv * lv;
+            sly += lv * y;
+            n += 1.0;
+        }
+        double denom = n * sll - sl * sl;
+        if (n < 2.0 || denom == 0.0) {
+            return 0.5;
+        }
+        return std::max(0.5, -(n * sly - sl * sy) / denom);
+    };
+
+    bool pending = true;
+    while (pending) {
+        for (std::size_t l = 0; l <= L; ++l) {
+            if (dn_l[l] == 0) {
+                continue;
+            }
+            LevelSums batch = sample_level(l, n_l[l], dn_l[l]);
+            sums[l].sum += batch.sum;
+            sums[l].sum_sq += batch.sum_sq;
+            n_l[l] += dn_l[l];
+        }
+
+        for (std::size_t l = 0; l <= L; ++l) {
+            double n = static_cast<double>(n_l[l]);
+            double mean = sums[l].sum / n;
+            m_l[l] = std::fabs(mean);
+            v_l[l] = std::max(0.0, sums[l].sum_sq / n - mean * mean);
+        }
+        alpha = decay_rate(m_l);
+        beta = decay_rate(v_l);
+        // Guard against spuriously small estimates on the finest levels.
+        for (std::size_t l = 2; l <= L; ++l) {
+            m_l[l] = std::max(m_l[l], 0.5 * m_l[l - 1] / std::pow(2.0, alpha));
+            v_l[l] = std::max(v_l[l], 0.5 * v_l[l - 1] / std::pow(2.0, beta));
+        }
+
+        optimal_samples();
+
+        bool converged = true;
+        for (std::size_t l = 0; l <= L; ++l) {
+            if (static_cast<double>(dn_l[l]) > 0.01 * static_cast<double>(n_l[l])) {
+                converged = false;
+            }
+        }
+        if (converged) {
+            double bias = std::max(m_l[L], (L > 0 ? 0.5 * m_l[L - 1] / std::pow(2.0, alpha) : 0.0)) /
+                          (std::pow(2.0, alpha) - 1.0);
+            if (bias > std::sqrt(theta) * mlmc_target_rmse_ && L < mlmc_max_level_) {
+                ++L;
+                n_l.push_back(0);
+                dn_l.push_back(0);
+                sums.emplace_back();
+                m_l.push_back(m_l[L - 1] / std::pow(2.0, alpha));
+                v_l.push_back(v_l[L - 1] / std::pow(2.0, beta));
+                optimal_samples();
             }
         }
+
+        pending = false;
+        for (std::size_t dn : dn_l) {
+            pending = pending || dn > 0;
+        }
+    }
+
+    double variance_of_mean = 0.0;
+    for (std::size_t l = 0; l <= L; ++l) {
+        double n = static_cast<double>(n_l[l]);
+        double mean = sums[l].sum / n;
+        outputs.value += mean;
+        variance_of_mean += std::max(0.0, sums[l].sum_sq / n - mean * mean) / n;
     }
+    double n0 = static_cast<double>(n_l[0]);
+    double mean0 = sums[0].sum / n0;
+    outputs.std_dev = std::sqrt(std::max(0.0, sums[0].sum_sq / n0 - mean0 * mean0));
+    outputs.std_error = std::sqrt(variance_of_mean);
+    return outputs;
+}
 
+template <typename Real>
+TimeMajorPaths<Real> BaseMCEngine::generatePaths(const core::OptionParams& params) const {
+    TimeMajorPaths<Real> paths;
+    paths.paths = paths_;
+    paths.steps = std::max<std::size_t>(1, time_steps_);
+    paths.spots.resize((paths.steps + 1) * paths_);
+    simulatePaths(params, [&paths](std::size_t i, const std::vector<double>& path) {
+        for (std::size_t step = 0; step <= paths.steps; ++step) {
+            paths.spots[step * paths.paths + i] = static_cast<Real>(path[step]);
+        }
+    });
     return paths;
 }
 
-void BaseMCEngine::applyVarianceReduction(std::vector<double>& discounted_payoffs,
-                                          const core::OptionSpec& spec,
-                                          const core::OptionParams& params) const {
-    (void)spec;
-    (void)params;
-    const bool use_antithetic = vr_method_ == VarianceReductionMethod::AntitheticVariates ||
-                                vr_method_ == VarianceReductionMethod::AntitheticMomentMatching;
-    if (!use_antithetic || discounted_payoffs.size() < 2) {
+template TimeMajorPaths<float> BaseMCEngine::generatePaths<float>(const core::OptionParams&) const;
+template TimeMajorPaths<double> BaseMCEngine::generatePaths<double>(const core::OptionParams&) const;
+
+BaseMCEngine::SampleStats::SampleStats(const BaseMCEngine& engine, std::size_t columns, bool control)
+    : columns_(columns),
+      control_(control),
+      paths_(engine.paths_),
+      replicates_(engine.qmcReplicates()),
+      antithetic_(engine.vr_method_ == VarianceReductionMethod::AntitheticVariates ||
+                  engine.vr_method_ == VarianceReductionMethod::AntitheticMomentMatching),
+      qmc_(engine.vr_method_ == VarianceReductionMethod::QuasiMonteCarlo),
+      first_of_pair_(antithetic_ ? columns + (control ? 1 : 0) : 0) {}
+
+void BaseMCEngine::SampleStats::add(std::size_t path_index, const double* samples) {
+    // A pair's first path waits for its twin; the run's last path may have none.
+    const std::size_t width = columns_ + (control_ ? 1 : 0);
+    if (antithetic_ && path_index % 2 == 0 && path_index + 1 < paths_) {
+        std::copy(samples, samples + width, first_of_pair_.begin());
+        pending_ = true;
         return;
     }
-    std::vector<double> reduced;
-    reduced.reserve((discounted_payoffs.size() + 1) / 2);
-    for (std::size_t i = 0; i < discounted_payoffs.size(); i += 2) {
-        if (i + 1 < discounted_payoffs.size()) {
-            reduced.push_back(0.5 * (discounted_payoffs[i] + discounted_payoffs[i + 1]));
+    // Replicate r owns paths [r * paths / R, (r + 1) * paths / R).
+    std::size_t replicate = qmc_ ? ((path_index + 1) * replicates_ - 1) / paths_ : 0;
+    if (groups_.empty() || groups_.back().replicate != replicate) {
+        groups_.push_back({replicate, std::vector<math::stats::RunningStats>(width), {}});
+    }
+    Group& group = groups_.back();
+    auto sample = [&](std::size_t c) { return pending_ ? 0.5 * (first_of_pair_[c] + samples[c]) : samples[c]; };
+    for (std::size_t c = 0; c < width; ++c) {
+        group.columns[c].add(sample(c));
+    }
+    if (control_) {
+        group.value_control.add(sample(0), sample(columns_));
+    }
+    pending_ = false;
+}
+
+void BaseMCEngine::SampleStats::add(const SampleStats& later) {
+    for (const Group& group : later.groups_) {
+        if (!groups_.empty() && groups_.back().replicate == group.replicate) {
+            for (std::size_t c = 0; c < group.columns.size(); ++c) {
+                groups_.back().columns[c].add(group.columns[c]);
+            }
+            groups_.back().value_control.add(group.value_control);
         } else {
-            reduced.push_back(discounted_payoffs[i]);
+            groups_.push_back(group);
         }
     }
-    discounted_payoffs.swap(reduced);
+}
+
+math::stats::RunningStats BaseMCEngine::SampleStats::column(std::size_t c) const {
+    math::stats::RunningStats stats;
+    for (const Group& group : groups_) {
+        if (qmc_) {
+            // Scrambled replicates are i.i.d.; their means are the samples for the error.
+            stats.add(group.columns[c].mean());
+        } else {
+            stats.add(group.columns[c]);
+        }
+    }
+    return stats;
+}
+
+math::stats::RunningCovariance BaseMCEngine::SampleStats::valueControl() const {
+    math::stats::RunningCovariance stats;
+    for (const Group& group : groups_) {
+        if (qmc_) {
+            stats.add(group.columns[0].mean(), group.columns[columns_].mean());
+        } else {
+            stats.add(group.value_control);
+        }
+    }
+    return stats;
+}
+
+void BaseMCEngine::SampleStats::write(PriceOutputs& outputs, bool greeks, double control_mean) const {
+    if (control_) {
+        math::stats::ControlVariateEstimate estimate = valueControl().control_variate(control_mean);
+        outputs.value = estimate.value;
+        outputs.std_dev = estimate.std_dev;
+        outputs.std_error = estimate.std_error;
+    } else {
+        math::stats::RunningStats value = column(0);
+        outputs.value = value.mean();
+        outputs.std_dev = value.standard_deviation();
+        outputs.std_error = value.standard_error();
+    }
+    if (greeks) {
+        math::stats::RunningStats delta = column(1);
+        math::stats::RunningStats vega = column(2);
+        outputs.delta = delta.mean();
+        outputs.delta_std_error = delta.standard_error();
+        outputs.vega = vega.mean();
+        outputs.vega_std_error = vega.standard_error();
+    }
+}
+
+BaseMCEngine::SampleStats BaseMCEngine::simulateSamples(const core::OptionParams& params, std::size_t columns,
+                                                        const PathSampler& sample, bool control) const {
+    // Blocks are simulated whole by one worker in path order, so each feeds its own
+    // instance; antithetic pairs never straddle two blocks.
+    const std::size_t blocks = (paths_ + PATH_BLOCK_SIZE - 1) / PATH_BLOCK_SIZE;
+    std::vector<SampleStats> partial(blocks, SampleStats(*this, columns, control));
+    simulatePaths(params, [&](std::size_t i, const std::vector<double>& path) {
+        thread_local std::vector<double> samples;
+        samples.assign(columns + (control ? 1 : 0), 0.0);
+        sample(path, samples.data());
+        partial[i / PATH_BLOCK_SIZE].add(i, samples.data());
+    });
+
+    SampleStats total(*this, columns, control);
+    for (const auto& p : partial) {
+        total.add(p);
+    }
+    return total;
+}
+
+GbmPathGreeks::GbmPathGreeks(const core::OptionParams& params, std::size_t steps)
+    : inv_spot_(1.0 / params.S),
+      sig_(params.sig),
+      dt_(params.T / static_cast<double>(std::max<std::size_t>(1, steps))),
+      sqrt_dt_(std::sqrt(dt_)),
+      drift_((params.r - params.q - 0.5 * params.sig * params.sig) * dt_),
+      vol_drift_(params.r - params.q + 0.5 * params.sig * params.sig) {}
+
+double GbmPathGreeks::spotVega(double spot, std::size_t step) const {
+    // dS/dsig = S (W - sig t), with sig W = log(S/S_0) - (r - q - sig^2/2) t.
+    return spot * (std::log(spot * inv_spot_) - vol_drift_ * dt_ * static_cast<double>(step)) / sig_;
+}
+
+double GbmPathGreeks::deltaScore(const std::vector<double>& path) const {
+    // Only the first increment's density depends on S_0.
+    double z = (std::log(path[1] * inv_spot_) - drift_) / (sig_ * sqrt_dt_);
+    return z * inv_spot_ / (sig_ * sqrt_dt_);
+}
+
+double GbmPathGreeks::vegaScore(const std::vector<double>& path) const {
+    double score = 0.0;
+    for (std::size_t k = 1; k < path.size(); ++k) {
+        double z = (std::log(path[k] / path[k - 1]) - drift_) / (sig_ * sqrt_dt_);
+        score += (z * z - 1.0) / sig_ - z * sqrt_dt_;
+    }
+    return score;
+}
+
+AdjointOutputs BaseMCEngine::priceAdjoint(const core::OptionParams& params, double strike,
+                                          const AdjointPayoff& payoff) const {
+    if (vr_method_ == VarianceReductionMethod::Multilevel) {
+        throw std::invalid_argument("BaseMCEngine: adjoint pricing does not support Multilevel Monte Carlo");
+    }
+    if (params.T <= 0.0 || params.sig <= 0.0) {
+        throw std::invalid_argument("BaseMCEngine: adjoint pricing needs T > 0 and sig > 0");
+    }
+
+    const std::size_t steps = std::max<std::size_t>(1, time_steps_);
+    const double dt = params.T / static_cast<double>(steps);
+    const double drift = (params.r - params.q - 0.5 * params.sig * params.sig) * dt;
+    const double diffusion = params.sig * std::sqrt(dt);
+
+    // Columns: value, then the gradient in OptionParams order.
+    constexpr std::size_t S = 1, K = 2, R = 3, Q = 4, SIG = 5, T = 6;
+    SampleStats stats = simulateSamples(params, 7, [&](const std::vector<double>& spots, double* samples) {
+        using math::aad::Number;
+        thread_local std::vector<double> z;
+        thread_local std::vector<Number> path;
+        z.resize(steps);
+        for (std::size_t k = 1; k <= steps; ++k) {
+            z[k - 1] = (std::log(spots[k] / spots[k - 1]) - drift) / diffusion;
+        }
+
+        math::aad::Tape& tape = math::aad::Tape::local();
+        tape.reset();
+        Number s0 = Number::variable(params.S);
+        Number k = Number::variable(strike);
+        Number r = Number::variable(params.r);
+        Number q = Number::variable(params.q);
+        Number sig = Number::variable(params.sig);
+        Number t = Number::variable(params.T);
+        Number step_dt = t / static_cast<double>(steps);
+        gbm_path(s0, (r - q - 0.5 * sig * sig) * step_dt, sig * sqrt(step_dt), z.data(), steps, path);
+        Number value = exp(-r * t) * payoff(path, k);
+        tape.propagate(value.node());
+
+        samples[0] = value.value();
+        samples[S] = s0.adjoint();
+        samples[K] = k.adjoint();
+        samples[R] = r.adjoint();
+        samples[Q] = q.adjoint();
+        samples[SIG] = sig.adjoint();
+        samples[T] = t.adjoint();
+    });
+
+    AdjointOutputs result{};
+    stats.write(result.outputs, false);
+    double* gradient[] = {nullptr, &result.gradient.S, &result.gradient.K, &result.gradient.r,
+                          &result.gradient.q, &result.gradient.sig, &result.gradient.T};
+    double* error[] = {nullptr, &result.std_error.S, &result.std_error.K, &result.std_error.r,
+                       &result.std_error.q, &result.std_error.sig, &result.std_error.T};
+    for (std::size_t c = S; c <= T; ++c) {
+        math::stats::RunningStats column = stats.column(c);
+        *gradient[c] = column.mean();
+        *error[c] = column.standard_error();
+    }
+    result.outputs.delta = result.gradient.S;
+    result.outputs.delta_std_error = result.std_error.S;
+    result.outputs.vega = result.gradient.sig;
+    result.outputs.vega_std_error = result.std_error.sig;
+    result.outputs.rho = result.gradient.r;
+    result.outputs.theta = -result.gradient.T;
+    return result;
 }
 
 }  // namespace engines
@@ -2,12 +2,72 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <vector>
 
 #include "engines/PricingEngine.hpp"
+#include "math/Adjoint.hpp"
+#include "math/Stats.hpp"
 
 namespace engines {
 
+// Every simulated path stored time-major, so the spots of all paths at one step are
+// contiguous: path i at step s is row(s)[i]. Real = float halves the footprint.
+template <typename Real>
+struct TimeMajorPaths {
+    std::size_t paths{0};
+    std::size_t steps{0};
+    std::vector<Real> spots;  // steps + 1 rows of `paths` spots
+
+    const Real* row(std::size_t step) const { return spots.data() + step * paths; }
+};
+
+// Derivatives of exact GBM paths, S_k = S_0 exp((r - q - sig^2/2) t_k + sig W_k), with
+// respect to S_0 and sig, recovered from the simulated spots alone.
+class GbmPathGreeks {
+  public:
+    GbmPathGreeks(const core::OptionParams& params, std::size_t steps);
+
+    // Pathwise: dS_k/dS_0 and dS_k/dsig of the spot at step k.
+    double spotDelta(double spot) const { return spot * inv_spot_; }
+    double spotVega(double spot, std::size_t step) const;
+
+    // Likelihood-ratio scores d log p/dS_0 and d log p/dsig of the path's density, for
+    // payoffs too discontinuous to differentiate (barriers).
+    double deltaScore(const std::vector<double>& path) const;
+    double vegaScore(const std::vector<double>& path) const;
+
+  private:
+    double inv_spot_;
+    double sig_;
+    double dt_;
+    double sqrt_dt_;
+    double drift_;      // (r - q - sig^2/2) dt
+    double vol_drift_;  // r - q + sig^2/2
+};
+
+// Spots of one GBM path, path[k] = path[k - 1] exp(drift + diffusion z[k - 1]) from
+// path[0] = spot, in any number type. The adjoint pricers replay each simulated path
+// this way on a tape, with z recovered from its double spots.
+template <typename Number>
+void gbm_path(const Number& spot, const Number& drift, const Number& diffusion, const double* z,
+              std::size_t steps, std::vector<Number>& path) {
+    path.resize(steps + 1);
+    path[0] = spot;
+    for (std::size_t k = 1; k <= steps; ++k) {
+        path[k] = path[k - 1] * exp(drift + diffusion * z[k - 1]);
+    }
+}
+
+// Price and its gradient with respect to every OptionParams input (K is the payoff
+// strike), from adjoint AD. `outputs` also carries delta, vega, rho and theta (-dV/dT);
+// `std_error` holds the standard error of each gradient entry.
+struct AdjointOutputs {
+    PriceOutputs outputs;
+    core::OptionParams gradient;
+    core::OptionParams std_error;
+};
+
 class BaseMCEngine : public PricingEngine {
    public:
     enum class VarianceReductionMethod {
@@ -19,6 +79,21 @@ class BaseMCEngine : public PricingEngine {
         Multilevel
     };
 
+    // Receives each simulated path (spots at steps 0..time_steps). The buffer is
+    // reused for the next path, so visitors must not keep a reference to it. With
+    // more than one thread, visitors run concurrently for distinct path indices.
+    using PathVisitor = std::function<void(std::size_t path_index, const std::vector<double>& path)>;
+
+    // Undiscounted payoff of one path of spots at steps 0..n (any n).
+    using PathPayoff = std::function<double(const std::vector<double>& path)>;
+
+    // Writes the discounted samples of one path (value first, then e.g. delta and vega).
+    using PathSampler = std::function<void(const std::vector<double>& path, double* samples)>;
+
+    // The same on the tape, with the strike as an input.
+    using AdjointPayoff =
+        std::function<math::aad::Number(const std::vector<math::aad::Number>& path, const math::aad::Number& strike)>;
+
     explicit BaseMCEngine(std::size_t paths = 20000,
                           std::size_t time_steps = 1,
                           std::uint64_t seed = 5489u,
@@ -33,12 +108,125 @@ class BaseMCEngine : public PricingEngine {
     PriceOutputs price(const core::OptionSpec& spec,
                        const core::OptionParams& params) const override = 0;
 
+    // Worker threads used for path simulation; 0 selects one per hardware thread.
+    // Results for a given seed are identical for every thread count.
+    void setThreadCount(std::size_t threads) { threads_ = threads; }
+    std::size_t getThreadCount() const { return threads_; }
+
+    // QuasiMonteCarlo: split the paths into `replicates` independently Owen-scrambled
+    // Sobol sets; the spread of the replicate means gives the standard error. Without
+    // scrambling a single deterministic set is used and no error is reported.
+    void setQmcScrambling(bool scramble, std::size_t replicates = 16) {
+        qmc_scramble_ = scramble;
+        qmc_replicates_ = replicates > 0 ? replicates : 1;
+    }
+
+    // Multilevel: level l simulates time_steps * 2^l steps, coupled with the level below
+    // through shared Brownian increments. Paths per level are chosen to reach
+    // `target_rmse` at minimum cost, starting from `pilot_paths` per level and adding
+    // levels up to `max_level` until the estimated discretisation bias is small enough.
+    void setMlmcOptions(double target_rmse, std::size_t pilot_paths = 2048, std::size_t max_level = 8) {
+        mlmc_target_rmse_ = target_rmse;
+        mlmc_pilot_paths_ = pilot_paths > 0 ? pilot_paths : 1;
+        mlmc_max_level_ = max_level;
+    }
+
+    // Delta and vega, with their standard errors, from the pricing paths themselves:
+    // pathwise derivatives for payoffs continuous in the path, likelihood-ratio weights
+    // for barriers. Off by default; Multilevel leaves them at zero.
+    void setPathGreeks(bool enabled) { path_greeks_ = enabled; }
+    bool getPathGreeks() const { return path_greeks_; }
+
+    // Control variate: each path also pays a control with a known price (discounted S_T
+    // for Europeans, the geometric Asian for arithmetic Asians, the European option for
+    // barriers, lookbacks and LSMC), and the price is the regression estimate with the
+    // optimal beta fitted on the same samples. Combines with the other methods (on QMC
+    // replicate means); Multilevel and the adjoint pricers ignore it. The Greeks are
+    // not adjusted.
+    void setControlVariate(bool enabled) { control_variate_ = enabled; }
+    bool getControlVariate() const { return control_variate_; }
+
    protected:
-    std::vector<std::vector<double>> generatePaths(const core::OptionParams& params) const;
+    // Running statistics of a fixed number of per-path sample columns, grouped the way
+    // the run pairs its paths: an antithetic pair (2k, 2k + 1) enters as its mean, and
+    // under QuasiMonteCarlo each replicate enters as its mean. One instance is fed a
+    // range of paths in path order; instances over consecutive ranges merge with add().
+    // With `control`, each path carries one more sample after the columns, a control
+    // whose covariance with column 0 is tracked for the control-variate estimate.
+    class SampleStats {
+      public:
+        SampleStats(const BaseMCEngine& engine, std::size_t columns, bool control = false);
+
+        void add(std::size_t path_index, const double* samples);
+        void add(const SampleStats& later);
+
+        // Statistics of column c over the grouped samples.
+        math::stats::RunningStats column(std::size_t c) const;
+
+        // Column 0 against the control.
+        math::stats::RunningCovariance valueControl() const;
+
+        // value, std_dev and std_error from column 0 and, with `greeks`, delta and vega
+        // with their errors from columns 1 and 2. With a control, the value and its errors
+        // are the control-variate estimate for a control of mean `control_mean`.
+        void write(PriceOutputs& outputs, bool greeks, double control_mean = 0.0) const;
+
+      private:
+        struct Group {
+            std::size_t replicate;
+            std::vector<math::stats::RunningStats> columns;
+            math::stats::RunningCovariance value_control;
+        };
+
+        std::size_t columns_;
+        bool control_;
+        std::size_t paths_;
+        std::size_t replicates_;
+        bool antithetic_;
+        bool qmc_;
+        bool pending_{false};
+        std::vector<double> first_of_pair_;
+        std::vector<Group> groups_;
+    };
+
+    // Number of scrambled replicates the QuasiMonteCarlo paths are split into.
+    std::size_t qmcReplicates() const;
+
+    // Streams paths one at a time through `visit`; memory use is independent of paths_.
+    void simulatePaths(const core::OptionParams& params, const PathVisitor& visit) const;
+
+    // Exact terminal sampling for payoffs of S_T alone: one step of length T whatever
+    // time_steps_ is, the discounted payoff (and pathwise delta and vega) evaluated per
+    // 64-path chunk and folded into per-block RunningStats. Nothing is stored per
+    // path. Handles None, antithetic and moment matching, and the control variate with
+    // discounted S_T as control. Same block substreams as simulatePaths, so results do
+    // not depend on the thread count.
+    PriceOutputs priceTerminal(const core::PlainVanillaPayoff& payoff, const core::OptionParams& params) const;
+
+    // Streams paths through `sample`, which writes `columns` samples per path (plus the
+    // control with `control`), into one SampleStats per path block, merged in block
+    // order. Nothing is stored per path.
+    SampleStats simulateSamples(const core::OptionParams& params, std::size_t columns, const PathSampler& sample,
+                                bool control = false) const;
+
+    // Sobol + Brownian bridge path construction used by simulatePaths for QuasiMonteCarlo.
+    void simulateSobolPaths(const core::OptionParams& params, const PathVisitor& visit) const;
+
+    // Multilevel Monte Carlo estimate of the discounted expected payoff (Giles, 2008).
+    // std_error is the estimator's standard error; std_dev is the level-0 sample std dev.
+    PriceOutputs priceMultilevel(const core::OptionParams& params, const PathPayoff& payoff) const;
+
+    // Materialises every path time-major (simulated in parallel like simulatePaths);
+    // only for engines that need the whole set at once (LSMC). Instantiated for float
+    // and double.
+    template <typename Real>
+    TimeMajorPaths<Real> generatePaths(const core::OptionParams& params) const;
 
-    virtual void applyVarianceReduction(std::vector<double>& discounted_payoffs,
-                                        const core::OptionSpec& spec,
-                                        const core::OptionParams& params) const;
+    // Adjoint pricing: each path from simulatePaths is replayed by gbm_path on the
+    // worker's tape with S, K, r, q, sig and T as inputs, its discounted payoff swept
+    // back once, and the tape rewound for the next path. Per-path gradients are grouped
+    // like the payoffs, so any variance reduction but Multilevel applies.
+    AdjointOutputs priceAdjoint(const core::OptionParams& params, double strike, const AdjointPayoff& payoff) const;
 
     void setVarianceReduction(VarianceReductionMethod method) { vr_method_ = method; }
     VarianceReductionMethod getVarianceReduction() const { return vr_method_; }
@@ -48,6 +236,14 @@ class BaseMCEngine : public PricingEngine {
     std::size_t time_steps_;
     std::uint64_t seed_;
     VarianceReductionMethod vr_method_ = VarianceReductionMethod::None;
+    std::size_t threads_ = 1;
+    bool qmc_scramble_ = true;
+    std::size_t qmc_replicates_ = 16;
+    double mlmc_target_rmse_ = 0.01;
+    std::size_t mlmc_pilot_paths_ = 2048;
+    std::size_t mlmc_max_level_ = 8;
+    bool path_greeks_ = false;
+    bool control_variate_ = false;
 };
 
 using VarianceReductionMethod = BaseMCEngine::VarianceReductionMethod;
@@ -1,12 +1,10 @@
 #include "engines/MCEuropean.hpp"
 
+#include <algorithm>
 #include <cmath>
-#include <random>
 #include <stdexcept>
 #include <vector>
 
-#include "math/Stats.hpp"
-
 namespace engines {
 
 PriceOutputs MCEuropeanEngine::price(const core::OptionSpec& spec,
@@ -23,26 +21,54 @@ PriceOutputs MCEuropeanEngine::price(const core::OptionSpec& spec,
         return outputs;
     }
 
-    auto paths = generatePaths(params);
-    std::vector<double> discounted_payoffs;
-    discounted_payoffs.reserve(paths.size());
+    if (vr_method_ == VarianceReductionMethod::Multilevel) {
+        return priceMultilevel(params, [&spec](const std::vector<double>& path) { return spec.payoff(path.back()); });
+    }
 
-    double discount = std::exp(-params.r * params.T);
-    for (const auto& path : paths) {
-        double payoff = spec.payoff(path.back());
-        discounted_payoffs.push_back(discount * payoff);
+    // GBM gives S_T exactly, so only QMC, whose points come from the Sobol path
+    // construction, walks paths.
+    if (vr_method_ != VarianceReductionMethod::QuasiMonteCarlo) {
+        return priceTerminal(spec.payoff, params);
     }
 
-    // Apply variance reduction if configured (to be implemented by subclasses or strategies)
-    applyVarianceReduction(discounted_payoffs, spec, params);
+    const double discount = std::exp(-params.r * params.T);
+    const std::size_t steps = std::max<std::size_t>(1, time_steps_);
+    const GbmPathGreeks greeks(params, steps);
+    const std::size_t columns = path_greeks_ ? 3 : 1;
+    SampleStats stats = simulateSamples(
+        params, columns,
+        [&](const std::vector<double>& path, double* samples) {
+            double ST = path.back();
+            samples[0] = discount * spec.payoff(ST);
+            if (path_greeks_) {
+                // Pathwise: the payoff is Lipschitz in S_T.
+                double slope = discount * spec.payoff.slope(ST);
+                samples[1] = slope * greeks.spotDelta(ST);
+                samples[2] = slope * greeks.spotVega(ST, steps);
+            }
+            if (control_variate_) {
+                samples[columns] = discount * ST;
+            }
+        },
+        control_variate_);
 
-    // Compute statistics
     PriceOutputs outputs{};
-    outputs.value = math::stats::mean(discounted_payoffs);
-    outputs.std_dev = math::stats::standard_deviation(discounted_payoffs);
-    outputs.std_error = math::stats::standard_error(discounted_payoffs);
-
+    stats.write(outputs, path_greeks_, params.S * std::exp(-params.q * params.T));
     return outputs;
 }
 
+AdjointOutputs MCEuropeanEngine::priceAdjoint(const core::OptionSpec& spec,
+                                              const core::OptionParams& params) const {
+    if (spec.exercise != core::ExerciseStyle::European) {
+        throw std::invalid_argument("MCEuropeanEngine: European exercise style required");
+    }
+    const bool call = spec.payoff.type == core::OptionType::Call;
+    return BaseMCEngine::priceAdjoint(
+        params, spec.payoff.strike,
+        [call](const std::vector<math::aad::Number>& path, const math::aad::Number& strike) {
+            const math::aad::Number& ST = path.back();
+            return max(call ? ST - strike : strike - ST, 0.0);
+        });
+}
+
 }  // namespace engines
@@ -19,6 +19,10 @@ class MCEuropeanEngine : public BaseMCEngine {
     PriceOutputs price(const core::OptionSpec& spec,
                        const core::OptionParams& params) const override;
 
+    // Value with delta, vega, rho, theta and the dK and dq sensitivities from one
+    // adjoint pass over the same paths as price(); see BaseMCEngine::priceAdjoint.
+    AdjointOutputs priceAdjoint(const core::OptionSpec& spec, const core::OptionParams& params) const;
+
 };  // class MCEuropeanEngine
 
 }  // namespace engines
@@ -1,18 +1,21 @@
 #include "engines/MCPathDependent.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
 
-#include "math/Stats.hpp"
+#include "engines/BSEuropeanAnalytic.hpp"
+#include "math/Normal.hpp"
 
 namespace engines {
 namespace {
 
-bool barrier_hit(const std::vector<double>& path, double barrier, core::BarrierType type) {
+template <typename Number>
+bool barrier_hit(const std::vector<Number>& path, double barrier, core::BarrierType type) {
     switch (type) {
         case core::BarrierType::UpAndOut:
         case core::BarrierType::UpAndIn:
-            for (double spot : path) {
+            for (const Number& spot : path) {
                 if (spot >= barrier) {
                     return true;
                 }
@@ -20,7 +23,7 @@ bool barrier_hit(const std::vector<double>& path, double barrier, core::BarrierT
             return false;
         case core::BarrierType::DownAndOut:
         case core::BarrierType::DownAndIn:
-            for (double spot : path) {
+            for (const Number& spot : path) {
                 if (spot <= barrier) {
                     return true;
                 }
@@ -30,39 +33,62 @@ bool barrier_hit(const std::vector<double>& path, double barrier, core::BarrierT
     return false;
 }
 
+// Discounted closed-form price of the geometric Asian on the same n + 1 spots
+// S_0, S_dt, ..., S_T as the arithmetic one. log G is normal with mean
+// log S + (r - q - sig^2/2) T / 2 and variance sig^2 dt n (2n + 1) / (6 (n + 1)).
+double geometric_asian_price(core::OptionType type, double strike, const core::OptionParams& params,
+                             std::size_t steps) {
+    const double n = static_cast<double>(steps);
+    const double dt = params.T / n;
+    const double mean = std::log(params.S) + (params.r - params.q - 0.5 * params.sig * params.sig) * 0.5 * params.T;
+    const double sd = params.sig * std::sqrt(dt * n * (2.0 * n + 1.0) / (6.0 * (n + 1.0)));
+    const double forward = std::exp(mean + 0.5 * sd * sd);
+    const double discount = std::exp(-params.r * params.T);
+    if (strike <= 0.0) {
+        return type == core::OptionType::Call ? discount * (forward - strike) : 0.0;
+    }
+    const double d2 = (mean - std::log(strike)) / sd;
+    const double d1 = d2 + sd;
+    if (type == core::OptionType::Call) {
+        return discount * (forward * math::normal::N(d1) - strike * math::normal::N(d2));
+    }
+    return discount * (strike * math::normal::N(-d2) - forward * math::normal::N(-d1));
+}
+
 }  // namespace
 
 PriceOutputs MCPathDependentEngine::price(const core::PathDependentOptionSpec& spec,
                                           const core::OptionParams& params) const {
-    auto paths = generatePaths(params);
-    std::vector<double> discounted;
-    discounted.reserve(paths.size());
+    if (vr_method_ == VarianceReductionMethod::Multilevel) {
+        return priceMultilevel(params, [&spec](const std::vector<double>& path) {
+            return path_payoff(spec, path, spec.strike);
+        });
+    }
 
+    const bool with_greeks = path_greeks_ && params.T > 0.0 && params.sig > 0.0;
     double discount = std::exp(-params.r * params.T);
+    const GbmPathGreeks greeks(params, std::max<std::size_t>(1, time_steps_));
 
-    for (const auto& path : paths) {
-        double payoff = 0.0;
-        switch (spec.type) {
-            case core::ExoticType::ArithmeticAsian:
-                payoff = asian_payoff(spec, path);
-                break;
-            case core::ExoticType::Barrier:
-                payoff = barrier_payoff(spec, path);
-                break;
-            case core::ExoticType::Lookback:
-                payoff = lookback_payoff(spec, path);
-                break;
-        }
-        discounted.push_back(discount * payoff);
-    }
-
-    core::OptionSpec dummy_spec{};
-    applyVarianceReduction(discounted, dummy_spec, params);
+    const bool with_control = control_variate_ && params.T > 0.0 && params.sig > 0.0;
+    const std::size_t columns = with_greeks ? 3 : 1;
+    SampleStats stats = simulateSamples(
+        params, columns,
+        [&](const std::vector<double>& path, double* samples) {
+            double payoff = path_payoff(spec, path, spec.strike);
+            samples[0] = discount * payoff;
+            if (with_greeks) {
+                path_greeks(spec, path, payoff, greeks, samples[1], samples[2]);
+                samples[1] *= discount;
+                samples[2] *= discount;
+            }
+            if (with_control) {
+                samples[columns] = discount * control_payoff(spec, path);
+            }
+        },
+        with_control);
 
     PriceOutputs outputs{};
-    outputs.value = math::stats::mean(discounted);
-    outputs.std_dev = math::stats::standard_deviation(discounted);
-    outputs.std_error = math::stats::standard_error(discounted);
+    stats.write(outputs, with_greeks, with_control ? control_price(spec, params) : 0.0);
     return outputs;
 }
 
@@ -73,42 +99,146 @@ PriceOutputs MCPathDependentEngine::price(const core::OptionSpec& spec,
     throw std::invalid_argument("MCPathDependentEngine requires PathDependentOptionSpec");
 }
 
-double MCPathDependentEngine::asian_payoff(const core::PathDependentOptionSpec& spec,
-                                            const std::vector<double>& path) {
-    double sum = 0.0;
-    for (double spot : path) {
+AdjointOutputs MCPathDependentEngine::priceAdjoint(const core::PathDependentOptionSpec& spec,
+                                                   const core::OptionParams& params) const {
+    return BaseMCEngine::priceAdjoint(
+        params, spec.strike,
+        [&spec](const std::vector<math::aad::Number>& path, const math::aad::Number& strike) {
+            return path_payoff(spec, path, strike);
+        });
+}
+
+double MCPathDependentEngine::control_payoff(const core::PathDependentOptionSpec& spec,
+                                             const std::vector<double>& path) {
+    const double sign = (spec.option_type == core::OptionType::Call) ? 1.0 : -1.0;
+    if (spec.type == core::ExoticType::ArithmeticAsian) {
+        double log_sum = 0.0;
+        for (double spot : path) {
+            log_sum += std::log(spot);
+        }
+        double geometric = std::exp(log_sum / static_cast<double>(path.size()));
+        return std::max(sign * (geometric - spec.strike), 0.0);
+    }
+    return std::max(sign * (path.back() - spec.strike), 0.0);
+}
+
+double MCPathDependentEngine::control_price(const core::PathDependentOptionSpec& spec,
+                                            const core::OptionParams& params) const {
+    if (spec.type == core::ExoticType::ArithmeticAsian) {
+        return geometric_asian_price(spec.option_type, spec.strike, params, std::max<std::size_t>(1, time_steps_));
+    }
+    core::OptionSpec european{{spec.strike, spec.option_type}, core::ExerciseStyle::European};
+    core::OptionParams european_params = params;
+    european_params.K = spec.strike;
+    return BSEuropeanAnalytic().price(european, european_params).value;
+}
+
+template <typename Number>
+Number MCPathDependentEngine::path_payoff(const core::PathDependentOptionSpec& spec,
+                                          const std::vector<Number>& path, const Number& strike) {
+    switch (spec.type) {
+        case core::ExoticType::ArithmeticAsian:
+            return asian_payoff(spec, path, strike);
+        case core::ExoticType::Barrier:
+            return barrier_payoff(spec, path, strike);
+        case core::ExoticType::Lookback:
+            return lookback_payoff(spec, path, strike);
+    }
+    return Number(0.0);
+}
+
+void MCPathDependentEngine::path_greeks(const core::PathDependentOptionSpec& spec,
+                                        const std::vector<double>& path, double payoff,
+                                        const GbmPathGreeks& greeks, double& delta, double& vega) {
+    delta = 0.0;
+    vega = 0.0;
+    if (path.size() < 2) {
+        return;
+    }
+    const double sign = (spec.option_type == core::OptionType::Call) ? 1.0 : -1.0;
+    switch (spec.type) {
+        case core::ExoticType::ArithmeticAsian: {
+            // Pathwise: d avg = mean of dS_k over the averaged spots.
+            if (payoff <= 0.0) {
+                return;
+            }
+            for (std::size_t k = 0; k < path.size(); ++k) {
+                delta += greeks.spotDelta(path[k]);
+                vega += greeks.spotVega(path[k], k);
+            }
+            delta *= sign / static_cast<double>(path.size());
+            vega *= sign / static_cast<double>(path.size());
+            return;
+        }
+        case core::ExoticType::Lookback: {
+            // Pathwise through the extreme spot.
+            if (payoff <= 0.0) {
+                return;
+            }
+            std::size_t extreme = 0;
+            for (std::size_t k = 1; k < path.size(); ++k) {
+                if (sign > 0.0 ? path[k] > path[extreme] : path[k] < path[extreme]) {
+                    extreme = k;
+                }
+            }
+            delta = sign * greeks.spotDelta(path[extreme]);
+            vega = sign * greeks.spotVega(path[extreme], extreme);
+            return;
+        }
+        case core::ExoticType::Barrier:
+            // Likelihood ratio: the knock indicator has no pathwise derivative.
+            if (payoff <= 0.0) {
+                return;
+            }
+            delta = payoff * greeks.deltaScore(path);
+            vega = payoff * greeks.vegaScore(path);
+            return;
+    }
+}
+
+template <typename Number>
+Number MCPathDependentEngine::asian_payoff(const core::PathDependentOptionSpec& spec,
+                                           const std::vector<Number>& path, const Number& strike) {
+    using std::max;
+    Number sum(0.0);
+    for (const Number& spot : path) {
         sum += spot;
     }
-    double avg = sum / static_cast<double>(path.size());
-    double intrinsic = (spec.option_type == core::OptionType::Call) ? (avg - spec.strike) : (spec.strike - avg);
-    return std::max(intrinsic, 0.0);
+    Number avg = sum / static_cast<double>(path.size());
+    Number intrinsic = (spec.option_type == core::OptionType::Call) ? (avg - strike) : (strike - avg);
+    return max(intrinsic, Number(0.0));
 }
 
-double MCPathDependentEngine::barrier_payoff(const core::PathDependentOptionSpec& spec,
-                                              const std::vector<double>& path) {
+template <typename Number>
+Number MCPathDependentEngine::barrier_payoff(const core::PathDependentOptionSpec& spec,
+                                             const std::vector<Number>& path, const Number& strike) {
+    using std::max;
     bool hit = barrier_hit(path, spec.barrier_level, spec.barrier_type);
     bool knock_in = (spec.barrier_type == core::BarrierType::UpAndIn ||
                      spec.barrier_type == core::BarrierType::DownAndIn);
     if ((knock_in && !hit) || (!knock_in && hit)) {
-        return 0.0;
+        return Number(0.0);
     }
-    double ST = path.back();
-    double intrinsic = (spec.option_type == core::OptionType::Call) ? (ST - spec.strike) : (spec.strike - ST);
-    return std::max(intrinsic, 0.0);
+    const Number& ST = path.back();
+    Number intrinsic = (spec.option_type == core::OptionType::Call) ? (ST - strike) : (strike - ST);
+    return max(intrinsic, Number(0.0));
 }
 
-double MCPathDependentEngine::lookback_payoff(const core::PathDependentOptionSpec& spec,
-                                               const std::vector<double>& path) {
-    double max_spot = path.front();
-    double min_spot = path.front();
-    for (double spot : path) {
-        max_spot = std::max(max_spot, spot);
-        min_spot = std::min(min_spot, spot);
+template <typename Number>
+Number MCPathDependentEngine::lookback_payoff(const core::PathDependentOptionSpec& spec,
+                                              const std::vector<Number>& path, const Number& strike) {
+    using std::max;
+    using std::min;
+    Number max_spot = path.front();
+    Number min_spot = path.front();
+    for (const Number& spot : path) {
+        max_spot = max(max_spot, spot);
+        min_spot = min(min_spot, spot);
     }
     if (spec.option_type == core::OptionType::Call) {
-        return std::max(max_spot - spec.strike, 0.0);
+        return max(max_spot - strike, Number(0.0));
     }
-    return std::max(spec.strike - min_spot, 0.0);
+    return max(strike - min_spot, Number(0.0));
 }
 
 }  // namespace engines
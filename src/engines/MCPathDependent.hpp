@@ -19,13 +19,34 @@ class MCPathDependentEngine : public BaseMCEngine {
     PriceOutputs price(const core::OptionSpec& spec,
                        const core::OptionParams& params) const override;
 
+    // Value and every OptionParams sensitivity (K is spec.strike) from one adjoint pass.
+    // Barrier knock indicators are constant on the tape, so barrier results omit the
+    // barrier-crossing term; use setPathGreeks for barrier delta and vega.
+    AdjointOutputs priceAdjoint(const core::PathDependentOptionSpec& spec,
+                                const core::OptionParams& params) const;
+
    private:
-    static double asian_payoff(const core::PathDependentOptionSpec& spec,
-                               const std::vector<double>& path);
-    static double barrier_payoff(const core::PathDependentOptionSpec& spec,
-                                 const std::vector<double>& path);
-    static double lookback_payoff(const core::PathDependentOptionSpec& spec,
-                                  const std::vector<double>& path);
+    // Payoffs are templated on the number type (double, or math::aad::Number on a tape).
+    template <typename Number>
+    static Number path_payoff(const core::PathDependentOptionSpec& spec,
+                              const std::vector<Number>& path, const Number& strike);
+    template <typename Number>
+    static Number asian_payoff(const core::PathDependentOptionSpec& spec,
+                               const std::vector<Number>& path, const Number& strike);
+    template <typename Number>
+    static Number barrier_payoff(const core::PathDependentOptionSpec& spec,
+                                 const std::vector<Number>& path, const Number& strike);
+    template <typename Number>
+    static Number lookback_payoff(const core::PathDependentOptionSpec& spec,
+                                  const std::vector<Number>& path, const Number& strike);
+    // Undiscounted control of a path and its exact discounted price: the geometric
+    // Asian on the same spots for arithmetic Asians, the European option on S_T with the
+    // same strike for barriers and lookbacks.
+    static double control_payoff(const core::PathDependentOptionSpec& spec, const std::vector<double>& path);
+    double control_price(const core::PathDependentOptionSpec& spec, const core::OptionParams& params) const;
+    // Per-path delta and vega samples (undiscounted) of a path paying `payoff`.
+    static void path_greeks(const core::PathDependentOptionSpec& spec, const std::vector<double>& path,
+                            double payoff, const GbmPathGreeks& greeks, double& delta, double& vega);
 };
 
 }  // namespace engines
@@ -0,0 +1,62 @@
+#include "engines/PricingEngine.hpp"
+
+#include <stdexcept>
+
+namespace engines {
+
+void PricingEngine::validateBatch(const core::OptionBatch& batch, const PriceOutputsBatch& outputs) {
+    const std::size_t n = batch.size();
+    if (batch.K.size() != n || batch.r.size() != n || batch.q.size() != n || batch.sig.size() != n ||
+        batch.T.size() != n || batch.type.size() != n || batch.exercise.size() != n) {
+        throw std::invalid_argument("priceBatch: input spans must all have the same length");
+    }
+    for (auto field : {outputs.value, outputs.delta, outputs.gamma, outputs.vega, outputs.theta, outputs.rho,
+                       outputs.std_dev, outputs.std_error}) {
+        if (!field.empty() && field.size() != n) {
+            throw std::invalid_argument("priceBatch: output spans must be empty or match the batch size");
+        }
+    }
+}
+
+void PricingEngine::storeOutputs(const PriceOutputsBatch& outputs, std::size_t index, const PriceOutputs& result) {
+    auto store = [index](std::span<double> field, double v) {
+        if (!field.empty()) {
+            field[index] = v;
+        }
+    };
+    store(outputs.value, result.value);
+    store(outputs.delta, result.delta);
+    store(outputs.gamma, result.gamma);
+    store(outputs.vega, result.vega);
+    store(outputs.theta, result.theta);
+    store(outputs.rho, result.rho);
+    store(outputs.std_dev, result.std_dev);
+    store(outputs.std_error, result.std_error);
+}
+
+void PricingEngine::priceBatch(const core::OptionBatch& batch, const PriceOutputsBatch& outputs) const {
+    validateBatch(batch, outputs);
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+        core::OptionSpec spec{{batch.K[i], batch.type[i]}, batch.exercise[i]};
+        core::OptionParams params{batch.S[i], batch.K[i], batch.r[i], batch.q[i], batch.sig[i], batch.T[i]};
+        storeOutputs(outputs, i, price(spec, params));
+    }
+}
+
+void PricingEngine::validateChain(std::span<const core::OptionSpec> specs, std::span<PriceOutputs> outputs) {
+    if (specs.size() != outputs.size()) {
+        throw std::invalid_argument("priceChain: specs and outputs must have the same length");
+    }
+}
+
+void PricingEngine::priceChain(const core::OptionParams& params, std::span<const core::OptionSpec> specs,
+                               std::span<PriceOutputs> outputs) const {
+    validateChain(specs, outputs);
+    core::OptionParams contract = params;
+    for (std::size_t i = 0; i < specs.size(); ++i) {
+        contract.K = specs[i].payoff.strike;
+        outputs[i] = price(specs[i], contract);
+    }
+}
+
+} // namespace engines
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <span>
+
 #include "core/Types.hpp"
 
 namespace engines {
@@ -13,12 +15,48 @@ struct PriceOutputs {
     double rho{0.0};
     double std_dev{0.0};
     double std_error{0.0};
+    double delta_std_error{0.0};  // MC engines with path Greeks enabled
+    double vega_std_error{0.0};
+};
+
+// Caller-owned structure-of-arrays results for PricingEngine::priceBatch. A non-empty
+// span must hold batch.size() entries; an empty span means the field is not wanted.
+struct PriceOutputsBatch {
+    std::span<double> value;
+    std::span<double> delta;
+    std::span<double> gamma;
+    std::span<double> vega;
+    std::span<double> theta;
+    std::span<double> rho;
+    std::span<double> std_dev;
+    std::span<double> std_error;
 };
 
 class PricingEngine {
   public:
     virtual ~PricingEngine() = default;
     virtual PriceOutputs price(const core::OptionSpec& spec, const core::OptionParams& params) const = 0;
+
+    // Prices every option in `batch` into `outputs`. The default loops over price();
+    // engines override it with kernels that work on the arrays directly.
+    virtual void priceBatch(const core::OptionBatch& batch, const PriceOutputsBatch& outputs) const;
+
+    // Prices contracts written on one underlying: all of them share `params` (params.K
+    // is ignored) and take strike, type and exercise from their spec. outputs[i] receives
+    // specs[i]. The default loops over price(); lattice engines run the chain on one tree.
+    virtual void priceChain(const core::OptionParams& params, std::span<const core::OptionSpec> specs,
+                            std::span<PriceOutputs> outputs) const;
+
+  protected:
+    // Throws std::invalid_argument unless all input spans and every requested output
+    // span match batch.size().
+    static void validateBatch(const core::OptionBatch& batch, const PriceOutputsBatch& outputs);
+
+    // Stores one option's results at `index`, skipping fields the caller did not request.
+    static void storeOutputs(const PriceOutputsBatch& outputs, std::size_t index, const PriceOutputs& result);
+
+    // Throws std::invalid_argument unless outputs has one entry per spec.
+    static void validateChain(std::span<const core::OptionSpec> specs, std::span<PriceOutputs> outputs);
 };
 
 } // namespace engines
@@ -1,28 +1,32 @@
 #include "engines/TrinomialTree.hpp"
 
 #include <algorithm>
+#include <barrier>
 #include <cmath>
 #include <stdexcept>
 #include <vector>
 
+#include "core/Parallel.hpp"
+#include "engines/LatticeKernels.hpp"
+
 namespace engines {
 
 namespace {
 constexpr double SQRT3 = 1.7320508075688772;
-}
 
-double TrinomialTreeEngine::value_from_tree(const core::OptionSpec& spec,
-                                            const core::OptionParams& params,
-                                            double spot) const {
-    if (steps_ == 0 || params.T <= 0.0 || params.sig <= 0.0) {
-        return spec.payoff(spot);
-    }
+// Per-step constants of the trinomial tree, with the discount folded into the
+// probabilities.
+struct TrinomialLattice {
+    double log_u{};
+    double disc_up{};
+    double disc_mid{};
+    double disc_down{};
+};
 
-    double dt = params.T / static_cast<double>(steps_);
+TrinomialLattice trinomial_lattice(const core::OptionParams& params, std::size_t steps) {
+    double dt = params.T / static_cast<double>(steps);
     double sqrt_dt = std::sqrt(dt);
     double disc = std::exp(-params.r * dt);
-    double u = std::exp(params.sig * std::sqrt(3.0 * dt));
-    double d = 1.0 / u;
 
     double drift = params.r - params.q;
     double a = drift - 0.5 * params.sig * params.sig;
@@ -43,35 +47,215 @@ double TrinomialTreeEngine::value_from_tree(const core::OptionSpec& spec,
         pd /= sum;
     }
 
-    int size = static_cast<int>(2 * steps_ + 1);
-    int offset = static_cast<int>(steps_);
-    std::vector<double> option_values(size, 0.0);
-    std::vector<double> next_values(size, 0.0);
+    TrinomialLattice tree;
+    tree.log_u = params.sig * std::sqrt(3.0 * dt);
+    tree.disc_up = disc * pu;
+    tree.disc_mid = disc * pm;
+    tree.disc_down = disc * pd;
+    return tree;
+}
 
+// Node j sits at spot u^j at every time step, so the 2N + 1 spots are computed once.
+std::vector<double> node_spots(double spot, double log_u, std::size_t steps) {
+    int offset = static_cast<int>(steps);
+    std::vector<double> spots(2 * steps + 1);
     for (int j = -offset; j <= offset; ++j) {
-        double ST = spot * std::pow(u, static_cast<double>(j));
-        option_values[j + offset] = spec.payoff(ST);
-    }
-
-    for (std::size_t step = steps_; step > 0; --step) {
-        std::fill(next_values.begin(), next_values.end(), 0.0);
-        int limit = static_cast<int>(step) - 1;
-        for (int j = -limit; j <= limit; ++j) {
-            double continuation = disc * (pu * option_values[(j + 1) + offset] +
-                                          pm * option_values[j + offset] +
-                                          pd * option_values[(j - 1) + offset]);
-            double node_spot = spot * std::pow(u, static_cast<double>(j));
-            if (spec.exercise == core::ExerciseStyle::American) {
-                next_values[j + offset] =
-                    std::max(continuation, spec.payoff(node_spot));
-            } else {
-                next_values[j + offset] = continuation;
-            }
+        spots[j + offset] = spot * std::exp(log_u * static_cast<double>(j));
+    }
+    return spots;
+}
+
+// Parallel induction. Each phase advances the live slice WAVEFRONT_STEPS steps: first
+// every tile of the slice steps its rows through a shrinking trapezoid in a private
+// buffer, exporting the two rows at each edge per step; then the triangles left
+// between neighbouring tiles are filled in from those edges. Workers meet at a barrier
+// after each half, so they synchronise twice per phase rather than once per step, and
+// every node is still computed once by the same kernel as the sequential loop.
+constexpr std::size_t WAVEFRONT_STEPS = 32;
+// Minimum tile height in rows: two tile buffers stay within L2, and a tile is always
+// tall enough (at least 2 WAVEFRONT_STEPS) for its trapezoid.
+constexpr std::size_t WAVEFRONT_TILE = 4096;
+
+struct Wavefront {
+    std::vector<double>& values;  // current slice, indexed by row
+    const double* spots;
+    lattice::TrinomialStep kernel;
+    TrinomialLattice tree;
+    double strike;
+    std::size_t steps;
+    std::vector<double> edges;  // per tile and step: two rows at the bottom, two at the top
+
+    // Tile t of `tiles` over the live rows [lo, lo + width).
+    static std::size_t tile_start(std::size_t lo, std::size_t width, std::size_t tiles, std::size_t t) {
+        return lo + t * width / tiles;
+    }
+
+    double* tile_edges(std::size_t t, std::size_t s) { return edges.data() + (t * WAVEFRONT_STEPS + s) * 4; }
+
+    // Rows [a + k, b - k) after k steps, for k up to WAVEFRONT_STEPS.
+    void trapezoid(std::size_t t, std::size_t a, std::size_t b, double* prev, double* next) {
+        const std::size_t w = b - a;
+        std::copy(values.begin() + a, values.begin() + b, prev);
+        for (std::size_t s = 0; s < WAVEFRONT_STEPS; ++s) {
+            double* edge = tile_edges(t, s);
+            edge[0] = prev[s];
+            edge[1] = prev[s + 1];
+            edge[2] = prev[w - s - 2];
+            edge[3] = prev[w - s - 1];
+            kernel(next + s + 1, prev + s + 1, spots + a + s + 1, w - 2 * (s + 1), tree.disc_up, tree.disc_mid,
+                   tree.disc_down, strike);
+            std::swap(prev, next);
         }
+        std::copy(prev + WAVEFRONT_STEPS, prev + w - WAVEFRONT_STEPS, values.begin() + a + WAVEFRONT_STEPS);
+    }
+
+    // Rows [b - k, b + k) after k steps, between tile t - 1 (below b) and tile t.
+    void triangle(std::size_t t, std::size_t b, double* prev, double* next) {
+        // Local row r is global row b - WAVEFRONT_STEPS - 1 + r.
+        const std::size_t mid = WAVEFRONT_STEPS + 1;
+        for (std::size_t s = 0; s < WAVEFRONT_STEPS; ++s) {
+            const double* below = tile_edges(t - 1, s);
+            const double* above = tile_edges(t, s);
+            prev[mid - s - 2] = below[2];
+            prev[mid - s - 1] = below[3];
+            prev[mid + s] = above[0];
+            prev[mid + s + 1] = above[1];
+            kernel(next + mid - s - 1, prev + mid - s - 1, spots + b - s - 1, 2 * (s + 1), tree.disc_up, tree.disc_mid,
+                   tree.disc_down, strike);
+            std::swap(prev, next);
+        }
+        std::copy(prev + 1, prev + 1 + 2 * WAVEFRONT_STEPS, values.begin() + b - WAVEFRONT_STEPS);
+    }
+
+    // Runs phases while the live slice splits into at least two tiles; returns the
+    // number of steps still to go.
+    std::size_t run(std::size_t workers) {
+        std::size_t end_level = steps;
+        while ((2 * end_level + 1) / WAVEFRONT_TILE >= 2) {
+            end_level -= WAVEFRONT_STEPS;
+        }
+        if (end_level == steps) {
+            return steps;
+        }
+        const std::size_t max_tiles = (2 * steps + 1) / WAVEFRONT_TILE;
+        edges.resize(max_tiles * WAVEFRONT_STEPS * 4);
+        workers = std::min(workers, max_tiles);
+
+        // Tiles are under 2 WAVEFRONT_TILE rows; each worker has two tile buffers.
+        const std::size_t buffer = 2 * WAVEFRONT_TILE;
+        std::vector<double> scratch(workers * 2 * buffer);
+        std::barrier sync(static_cast<std::ptrdiff_t>(workers));
+        core::parallel_team(workers, [&](std::size_t worker) {
+            double* prev = scratch.data() + worker * 2 * buffer;
+            double* next = prev + buffer;
+            for (std::size_t level = steps; level > end_level; level -= WAVEFRONT_STEPS) {
+                const std::size_t lo = steps - level;
+                const std::size_t width = 2 * level + 1;
+                const std::size_t tiles = width / WAVEFRONT_TILE;
+                const std::size_t first = worker * tiles / workers;
+                const std::size_t last = (worker + 1) * tiles / workers;
+                for (std::size_t t = first; t < last; ++t) {
+                    trapezoid(t, tile_start(lo, width, tiles, t), tile_start(lo, width, tiles, t + 1), prev, next);
+                }
+                sync.arrive_and_wait();
+                for (std::size_t t = std::max<std::size_t>(first, 1); t < last; ++t) {
+                    triangle(t, tile_start(lo, width, tiles, t), prev, next);
+                }
+                sync.arrive_and_wait();
+            }
+        });
+        return end_level;
+    }
+};
+
+// Delta and gamma from trees rebuilt at S e^{+-bump}.
+void bump_greeks(double S, double spot_up, double spot_down, double base, double up, double down,
+                 PriceOutputs& outputs) {
+    double h_up = spot_up - S;
+    double h_down = S - spot_down;
+    double denom_delta = spot_up - spot_down;
+    if (denom_delta > 0.0) {
+        outputs.delta = (up - down) / denom_delta;
+    }
+    double gamma_denom = h_up * h_down * (h_up + h_down);
+    if (h_up > 0.0 && h_down > 0.0 && gamma_denom != 0.0) {
+        outputs.gamma = 2.0 *
+                        (h_down * up - (h_up + h_down) * base + h_up * down) /
+                        gamma_denom;
+    }
+}
+
+} // namespace
+
+double TrinomialTreeEngine::value_from_tree(const core::OptionSpec& spec,
+                                            const core::OptionParams& params,
+                                            double spot) const {
+    if (steps_ == 0 || params.T <= 0.0 || params.sig <= 0.0) {
+        return spec.payoff(spot);
+    }
+
+    TrinomialLattice tree = trinomial_lattice(params, steps_);
+    std::vector<double> spots = node_spots(spot, tree.log_u, steps_);
+    std::vector<double> option_values(spots.size());
+    for (std::size_t j = 0; j < spots.size(); ++j) {
+        option_values[j] = spec.payoff(spots[j]);
+    }
+    std::vector<double> next_values(spots.size(), 0.0);
+
+    lattice::TrinomialStep step_kernel = lattice::trinomial_kernel(spec.exercise, spec.payoff.type);
+    std::size_t remaining = steps_;
+    std::size_t workers = core::resolve_threads(threads_);
+    if (workers > 1) {
+        Wavefront wavefront{option_values, spots.data(), step_kernel, tree, spec.payoff.strike, steps_, {}};
+        remaining = wavefront.run(workers);
+    }
+    for (std::size_t step = remaining; step > 0; --step) {
+        // The new slice spans nodes -(step - 1)..step - 1 and reads one node further out.
+        std::size_t first = steps_ - (step - 1);
+        step_kernel(next_values.data() + first, option_values.data() + first, spots.data() + first, 2 * step - 1,
+                    tree.disc_up, tree.disc_mid, tree.disc_down, spec.payoff.strike);
         option_values.swap(next_values);
     }
 
-    return option_values[offset];
+    return option_values[steps_];
+}
+
+void TrinomialTreeEngine::chain_from_tree(const core::OptionParams& params, double spot,
+                                          const lattice::ChainPayoffs& payoffs, std::span<double> values) const {
+    constexpr std::size_t B = lattice::CHAIN_BLOCK;
+    TrinomialLattice tree = trinomial_lattice(params, steps_);
+    std::vector<double> spots = node_spots(spot, tree.log_u, steps_);
+    const std::size_t rows = spots.size();
+
+    // One column of `rows` nodes per block of lanes; lane j of the chain is lane j % B
+    // of column j / B.
+    std::vector<double> option_values(payoffs.width() * rows);
+    std::vector<lattice::TrinomialChainSweep> kernels;
+    for (const auto& group : payoffs.groups) {
+        for (std::size_t j = group.first; j < group.first + group.lanes; ++j) {
+            double* column = option_values.data() + (j / B) * rows * B;
+            for (std::size_t i = 0; i < rows; ++i) {
+                column[i * B + j % B] = core::PlainVanillaPayoff{payoffs.strike[j], group.type}(spots[i]);
+            }
+        }
+        kernels.insert(kernels.end(), group.lanes / B, lattice::trinomial_chain_kernel(group.exercise, group.type));
+    }
+
+    // With `level` steps to go the live rows are steps_ - level .. steps_ + level.
+    for (std::size_t level = steps_; level > 0;) {
+        std::size_t levels = std::min(lattice::CHAIN_LEVELS, level);
+        std::size_t bottom = steps_ - level;
+        for (std::size_t b = 0; b < kernels.size(); ++b) {
+            kernels[b](option_values.data() + (b * rows + bottom) * B, spots.data() + bottom, levels, 2 * level,
+                       payoffs.strike.data() + b * B, tree.disc_up, tree.disc_mid, tree.disc_down);
+        }
+        level -= levels;
+    }
+
+    for (std::size_t j = 0; j < values.size(); ++j) {
+        std::size_t lane = payoffs.lane[j];
+        values[j] = option_values[((lane / B) * rows + steps_) * B + lane % B];
+    }
 }
 
 PriceOutputs TrinomialTreeEngine::price(const core::OptionSpec& spec,
@@ -90,18 +274,7 @@ PriceOutputs TrinomialTreeEngine::price(const core::OptionSpec& spec,
         double spot_down = params.S * std::exp(-log_bump);
         double up = value_from_tree(spec, params, spot_up);
         double down = value_from_tree(spec, params, spot_down);
-        double h_up = spot_up - params.S;
-        double h_down = params.S - spot_down;
-        double denom_delta = spot_up - spot_down;
-        if (denom_delta > 0.0) {
-            outputs.delta = (up - down) / denom_delta;
-        }
-        double gamma_denom = h_up * h_down * (h_up + h_down);
-        if (h_up > 0.0 && h_down > 0.0 && gamma_denom != 0.0) {
-            outputs.gamma = 2.0 *
-                            (h_down * up - (h_up + h_down) * base + h_up * down) /
-                            gamma_denom;
-        }
+        bump_greeks(params.S, spot_up, spot_down, base, up, down, outputs);
     }
 
     outputs.std_dev = 0.0;
@@ -116,4 +289,41 @@ PriceOutputs TrinomialTreeEngine::priceAmerican(const core::OptionSpec& spec,
     return price(american_spec, params);
 }
 
+void TrinomialTreeEngine::priceChain(const core::OptionParams& params, std::span<const core::OptionSpec> specs,
+                                     std::span<PriceOutputs> outputs) const {
+    validateChain(specs, outputs);
+    if (steps_ == 0) {
+        throw std::invalid_argument("Trinomial engine requires at least one step");
+    }
+    if (specs.empty()) {
+        return;
+    }
+    if (params.T <= 0.0 || params.sig <= 0.0) {
+        // Every contract is worth its payoff; the tree has nothing to share.
+        PricingEngine::priceChain(params, specs, outputs);
+        return;
+    }
+
+    const std::size_t n = specs.size();
+    lattice::ChainPayoffs payoffs(specs);
+    std::vector<double> base(n);
+    chain_from_tree(params, params.S, payoffs, base);
+    std::fill(outputs.begin(), outputs.end(), PriceOutputs{});
+    for (std::size_t j = 0; j < n; ++j) {
+        outputs[j].value = base[j];
+    }
+
+    if (params.S > 0.0 && bump_size_ > 0.0) {
+        double spot_up = params.S * std::exp(bump_size_);
+        double spot_down = params.S * std::exp(-bump_size_);
+        std::vector<double> up(n);
+        std::vector<double> down(n);
+        chain_from_tree(params, spot_up, payoffs, up);
+        chain_from_tree(params, spot_down, payoffs, down);
+        for (std::size_t j = 0; j < n; ++j) {
+            bump_greeks(params.S, spot_up, spot_down, base[j], up[j], down[j], outputs[j]);
+        }
+    }
+}
+
 } // namespace engines
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 
 #include "engines/PricingEngine.hpp"
 
 namespace engines {
 
+namespace lattice {
+struct ChainPayoffs;
+}
+
 class TrinomialTreeEngine : public PricingEngine {
   public:
     explicit TrinomialTreeEngine(std::size_t steps = 4000, double bump = 0.0005)
@@ -16,12 +21,28 @@ class TrinomialTreeEngine : public PricingEngine {
     PriceOutputs priceAmerican(const core::OptionSpec& spec,
                                const core::OptionParams& params) const;
 
+    // Prices the whole chain on one tree with the strike dimension vectorised; results
+    // match price() per spec.
+    void priceChain(const core::OptionParams& params, std::span<const core::OptionSpec> specs,
+                    std::span<PriceOutputs> outputs) const override;
+
+    // Worker threads for the backward induction of price(); 0 selects one per hardware
+    // thread. Wide slices are split into tiles advanced several steps per barrier;
+    // results are identical for every thread count.
+    void setThreadCount(std::size_t threads) { threads_ = threads; }
+    std::size_t getThreadCount() const { return threads_; }
+
   private:
     double value_from_tree(const core::OptionSpec& spec, const core::OptionParams& params,
                            double spot) const;
+    // One backward induction for the whole chain, values[j] for the j-th spec; needs
+    // at least one step and T > 0.
+    void chain_from_tree(const core::OptionParams& params, double spot, const lattice::ChainPayoffs& payoffs,
+                         std::span<double> values) const;
 
     std::size_t steps_;
     double bump_size_;
+    std::size_t threads_ = 1;
 };
 
 } // namespace engines
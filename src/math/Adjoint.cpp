@@ -0,0 +1,30 @@
+#include "math/Adjoint.hpp"
+
+namespace math {
+namespace aad {
+
+void Tape::propagate(std::size_t output) {
+    if (output == NONE) {
+        return;
+    }
+    for (std::size_t i = 0; i <= output; ++i) {
+        at(i).adjoint = 0.0;
+    }
+    at(output).adjoint = 1.0;
+    for (std::size_t i = output + 1; i-- > 0;) {
+        const Node& node = at(i);
+        double adjoint = node.adjoint;
+        if (adjoint == 0.0) {
+            continue;
+        }
+        if (node.arg[0] != NONE) {
+            at(node.arg[0]).adjoint += node.partial[0] * adjoint;
+        }
+        if (node.arg[1] != NONE) {
+            at(node.arg[1]).adjoint += node.partial[1] * adjoint;
+        }
+    }
+}
+
+} // namespace aad
+} // namespace math
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Tape-based reverse-mode algorithmic differentiation. Arithmetic on Number records
+// one node per operation (at most two arguments with their local partials) on the
+// calling thread's tape; propagate() then sweeps the tape backwards once, giving the
+// derivative of one output with respect to every recorded input. Nodes live in
+// fixed-size blocks that reset() rewinds without freeing, so a tape reused across
+// paths and pricings stops allocating once it has grown to its working size.
+namespace math {
+namespace aad {
+
+class Tape {
+  public:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    // The calling thread's tape, which every Number operation records on.
+    static Tape& local() {
+        thread_local Tape tape;
+        return tape;
+    }
+
+    // Forgets every node; the arena blocks are kept for the next recording.
+    void reset() { size_ = 0; }
+    std::size_t size() const { return size_; }
+
+    std::size_t leaf() { return push(NONE, 0.0, NONE, 0.0); }
+    std::size_t record(std::size_t arg, double partial) { return push(arg, partial, NONE, 0.0); }
+    std::size_t record(std::size_t arg0, double partial0, std::size_t arg1, double partial1) {
+        return push(arg0, partial0, arg1, partial1);
+    }
+
+    // Sets the adjoint of `output` to 1 and accumulates adjoints down to node 0.
+    void propagate(std::size_t output);
+    double adjoint(std::size_t node) const { return node == NONE ? 0.0 : at(node).adjoint; }
+
+  private:
+    struct Node {
+        std::size_t arg[2];
+        double partial[2];
+        double adjoint;
+    };
+
+    static constexpr std::size_t BLOCK_BITS = 14;  // 16384 nodes (512 KiB) per block
+    static constexpr std::size_t BLOCK_SIZE = std::size_t{1} << BLOCK_BITS;
+
+    Node& at(std::size_t i) { return blocks_[i >> BLOCK_BITS][i & (BLOCK_SIZE - 1)]; }
+    const Node& at(std::size_t i) const { return blocks_[i >> BLOCK_BITS][i & (BLOCK_SIZE - 1)]; }
+
+    std::size_t push(std::size_t arg0, double partial0, std::size_t arg1, double partial1) {
+        if ((size_ >> BLOCK_BITS) == blocks_.size()) {
+            blocks_.push_back(std::make_unique<Node[]>(BLOCK_SIZE));
+        }
+        at(size_) = Node{{arg0, arg1}, {partial0, partial1}, 0.0};
+        return size_++;
+    }
+
+    std::vector<std::unique_ptr<Node[]>> blocks_;
+    std::size_t size_{0};
+};
+
+// A double with its node on the thread's tape. Numbers built from a plain double are
+// constants: they record nothing, and operations with them record a single argument.
+class Number {
+  public:
+    Number(double value = 0.0) : value_(value) {}
+
+    // A new input on the thread's tape.
+    static Number variable(double value) { return Number(value, Tape::local().leaf()); }
+
+    double value() const { return value_; }
+    std::size_t node() const { return node_; }
+    // d output / d this after the last Tape::propagate().
+    double adjoint() const { return Tape::local().adjoint(node_); }
+
+    Number& operator+=(const Number& other) { return *this = *this + other; }
+    Number& operator-=(const Number& other) { return *this = *this - other; }
+    Number& operator*=(const Number& other) { return *this = *this * other; }
+    Number& operator/=(const Number& other) { return *this = *this / other; }
+
+    friend Number operator+(const Number& a, const Number& b) { return binary(a.value_ + b.value_, a, 1.0, b, 1.0); }
+    friend Number operator-(const Number& a, const Number& b) { return binary(a.value_ - b.value_, a, 1.0, b, -1.0); }
+    friend Number operator*(const Number& a, const Number& b) {
+        return binary(a.value_ * b.value_, a, b.value_, b, a.value_);
+    }
+    friend Number operator/(const Number& a, const Number& b) {
+        double inv = 1.0 / b.value_;
+        double q = a.value_ * inv;
+        return binary(q, a, inv, b, -q * inv);
+    }
+    friend Number operator-(const Number& a) { return unary(-a.value_, a, -1.0); }
+
+    friend Number exp(const Number& a) {
+        double e = std::exp(a.value_);
+        return unary(e, a, e);
+    }
+    friend Number log(const Number& a) { return unary(std::log(a.value_), a, 1.0 / a.value_); }
+    friend Number sqrt(const Number& a) {
+        double s = std::sqrt(a.value_);
+        return unary(s, a, 0.5 / s);
+    }
+    // The selected argument itself, so no node is recorded.
+    friend Number max(const Number& a, const Number& b) { return a.value_ >= b.value_ ? a : b; }
+    friend Number min(const Number& a, const Number& b) { return a.value_ <= b.value_ ? a : b; }
+
+    friend bool operator<(const Number& a, const Number& b) { return a.value_ < b.value_; }
+    friend bool operator>(const Number& a, const Number& b) { return a.value_ > b.value_; }
+    friend bool operator<=(const Number& a, const Number& b) { return a.value_ <= b.value_; }
+    friend bool operator>=(const Number& a, const Number& b) { return a.value_ >= b.value_; }
+
+  private:
+    Number(double value, std::size_t node) : value_(value), node_(node) {}
+
+    static Number unary(double value, const Number& a, double partial) {
+        if (a.node_ == Tape::NONE) {
+            return Number(value);
+        }
+        return Number(value, Tape::local().record(a.node_, partial));
+    }
+    static Number binary(double value, const Number& a, double pa, const Number& b, double pb) {
+        if (a.node_ == Tape::NONE) {
+            return unary(value, b, pb);
+        }
+        if (b.node_ == Tape::NONE) {
+            return unary(value, a, pa);
+        }
+        return Number(value, Tape::local().record(a.node_, pa, b.node_, pb));
+    }
+
+    double value_;
+    std::size_t node_{Tape::NONE};
+};
+
+} // namespace aad
+} // namespace math
@@ -0,0 +1,66 @@
+#include "math/BrownianBridge.hpp"
+
+#include <cmath>
+
+namespace math {
+
+BrownianBridge::BrownianBridge(std::size_t steps)
+    : steps_(steps),
+      left_index_(steps, 0),
+      right_index_(steps, 0),
+      bridge_index_(steps, 0),
+      left_weight_(steps, 0.0),
+      right_weight_(steps, 0.0),
+      std_dev_(steps, 0.0) {
+    if (steps_ == 0) {
+        return;
+    }
+
+    // map[k] != 0 marks grid points whose value is already constructed.
+    std::vector<std::size_t> map(steps_, 0);
+    auto t = [](std::size_t k) { return static_cast<double>(k + 1); };
+
+    map[steps_ - 1] = 1;
+    bridge_index_[0] = steps_ - 1;
+    std_dev_[0] = std::sqrt(t(steps_ - 1));
+
+    std::size_t j = 0;
+    for (std::size_t i = 1; i < steps_; ++i) {
+        while (map[j] != 0) {
+            ++j;
+        }
+        std::size_t k = j;
+        while (map[k] == 0) {
+            ++k;
+        }
+        std::size_t l = j + ((k - 1 - j) >> 1);
+        map[l] = i;
+        bridge_index_[i] = l;
+        left_index_[i] = j;
+        right_index_[i] = k;
+        double t_left = (j != 0) ? t(j - 1) : 0.0;
+        left_weight_[i] = (t(k) - t(l)) / (t(k) - t_left);
+        right_weight_[i] = (t(l) - t_left) / (t(k) - t_left);
+        std_dev_[i] = std::sqrt((t(l) - t_left) * (t(k) - t(l)) / (t(k) - t_left));
+        j = k + 1;
+        if (j >= steps_) {
+            j = 0;
+        }
+    }
+}
+
+void BrownianBridge::transform(const double* normals, double* w) const {
+    if (steps_ == 0) {
+        return;
+    }
+    w[steps_ - 1] = std_dev_[0] * normals[0];
+    for (std::size_t i = 1; i < steps_; ++i) {
+        std::size_t j = left_index_[i];
+        std::size_t k = right_index_[i];
+        std::size_t l = bridge_index_[i];
+        double left = (j != 0) ? left_weight_[i] * w[j - 1] : 0.0;
+        w[l] = left + right_weight_[i] * w[k] + std_dev_[i] * normals[i];
+    }
+}
+
+} // namespace math
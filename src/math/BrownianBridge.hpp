@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace math {
+
+// Brownian bridge construction on the uniform grid t_i = i, i = 1..steps (Jaeckel's
+// ordering). The first normal fixes W(steps), the next ones fill midpoints, so the
+// leading dimensions of a low-discrepancy point carry most of the path's variance.
+class BrownianBridge {
+  public:
+    explicit BrownianBridge(std::size_t steps);
+
+    std::size_t size() const { return steps_; }
+
+    // Maps `steps` standard normals to W(t_1), ..., W(t_steps) with unit time step;
+    // scale by sqrt(dt) for a grid of spacing dt.
+    void transform(const double* normals, double* w) const;
+
+  private:
+    std::size_t steps_;
+    std::vector<std::size_t> left_index_;
+    std::vector<std::size_t> right_index_;
+    std::vector<std::size_t> bridge_index_;
+    std::vector<double> left_weight_;
+    std::vector<double> right_weight_;
+    std::vector<double> std_dev_;
+};
+
+} // namespace math
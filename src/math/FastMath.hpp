@@ -0,0 +1,197 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+// Branch-free elementary functions for batch kernels. Each is a straight-line
+// polynomial/rational evaluation with selects instead of branches and no libm
+// calls, so loops over arrays auto-vectorise (SSE2/AVX2/AVX-512/NEON) when the
+// functions are inlined into the loop body. Accuracy against std:: / Boost over the
+// ranges the pricing kernels use is noted on each function.
+
+#if defined(__GNUC__) || defined(__clang__)
+#define MATH_FAST_INLINE inline __attribute__((always_inline))
+#else
+#define MATH_FAST_INLINE inline
+#endif
+
+namespace math {
+namespace fast {
+
+// c ? a : b as a bitwise blend. Plain ?: on doubles is kept as a branch by GCC under
+// the default -ftrapping-math, which blocks vectorisation below AVX-512.
+MATH_FAST_INLINE double select(bool c, double a, double b) {
+    std::uint64_t mask = 0 - static_cast<std::uint64_t>(c);
+    return std::bit_cast<double>((std::bit_cast<std::uint64_t>(a) & mask) |
+                                 (std::bit_cast<std::uint64_t>(b) & ~mask));
+}
+
+// e^x for x in [-708, 709] (clamped outside). Cody-Waite reduction x = n ln2 + r,
+// |r| <= ln2/2, then a degree-13 Taylor polynomial. Max relative error vs std::exp
+// 2.2e-16 (about 1 ulp).
+MATH_FAST_INLINE double exp(double x) {
+    constexpr double log2e = 1.4426950408889634;
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    constexpr double shifter = 6755399441055744.0;  // 1.5 * 2^52: rounds to integer in the low bits
+
+    x = select(x < -708.0, -708.0, x);
+    x = select(x > 709.0, 709.0, x);
+    double t = x * log2e + shifter;
+    double n = t - shifter;
+    double r = (x - n * ln2_hi) - n * ln2_lo;
+
+    double p = 1.0 / 6227020800.0;
+    p = p * r + 1.0 / 479001600.0;
+    p = p * r + 1.0 / 39916800.0;
+    p = p * r + 1.0 / 3628800.0;
+    p = p * r + 1.0 / 362880.0;
+    p = p * r + 1.0 / 40320.0;
+    p = p * r + 1.0 / 5040.0;
+    p = p * r + 1.0 / 720.0;
+    p = p * r + 1.0 / 120.0;
+    p = p * r + 1.0 / 24.0;
+    p = p * r + 1.0 / 6.0;
+    p = p * r + 0.5;
+    p = p * r + 1.0;
+    p = p * r + 1.0;
+
+    // The low mantissa bits of t hold n; move n + 1023 into the exponent field.
+    std::uint64_t scale = (std::bit_cast<std::uint64_t>(t) + 1023u) << 52;
+    return p * std::bit_cast<double>(scale);
+}
+
+// Natural log for positive normal x. Splits x = 2^e m with m in [sqrt(1/2), sqrt(2))
+// and sums 2 atanh((m - 1)/(m + 1)) to degree 21. Max relative error vs std::log
+// 4.4e-16 (2 ulp); absolute error below 1e-18 near x = 1.
+MATH_FAST_INLINE double log(double x) {
+    constexpr double ln2_hi = 6.93147180369123816490e-01;
+    constexpr double ln2_lo = 1.90821492927058770002e-10;
+    constexpr double two52 = 4503599627370496.0;
+
+    std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+    // Exponent to double without an int->double conversion (none in AVX2 for 64-bit).
+    double e = std::bit_cast<double>((bits >> 52) | 0x4330000000000000ull) - two52 - 1023.0;
+    double m = std::bit_cast<double>((bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+    bool high = m > 1.4142135623730951;
+    m = select(high, 0.5 * m, m);
+    e = select(high, e + 1.0, e);
+
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double p = 1.0 / 21.0;
+    p = p * s2 + 1.0 / 19.0;
+    p = p * s2 + 1.0 / 17.0;
+    p = p * s2 + 1.0 / 15.0;
+    p = p * s2 + 1.0 / 13.0;
+    p = p * s2 + 1.0 / 11.0;
+    p = p * s2 + 1.0 / 9.0;
+    p = p * s2 + 1.0 / 7.0;
+    p = p * s2 + 1.0 / 5.0;
+    p = p * s2 + 1.0 / 3.0;
+    p = p * s2 + 1.0;
+    return e * ln2_hi + (2.0 * s * p + e * ln2_lo);
+}
+
+// Square root of positive normal x: three Newton steps on 1/sqrt(x) from the bit-level
+// estimate, then one on the root itself. Max relative error vs std::sqrt 2.2e-16. libm
+// sqrt sets errno on negative input, which keeps GCC from vectorising it.
+MATH_FAST_INLINE double sqrt(double x) {
+    double y = std::bit_cast<double>(0x5FE6EB50C7B537A9ull - (std::bit_cast<std::uint64_t>(x) >> 1));
+    double h = 0.5 * x;
+    y = y * (1.5 - h * y * y);
+    y = y * (1.5 - h * y * y);
+    y = y * (1.5 - h * y * y);
+    double s = x * y;
+    return s + 0.5 * y * (x - s * s);
+}
+
+// N(-|x|), the lower normal tail, by Hart's double-precision algorithm as given in
+// West (2005), "Better approximations to cumulative normal functions": a rational in
+// |x| below 7.07 and a continued fraction above; both are evaluated and selected.
+// Max absolute error vs boost::math::cdf 2.2e-16. Relative error of the tail is
+// 1.6e-15 for |x| < 2 and 2.6e-13 for |x| < 5, rising to 9e-9 around |x| = 7 where
+// the tail itself is below 1e-11.
+MATH_FAST_INLINE double normal_tail(double x) {
+    double z = std::fabs(x);
+    double e = exp(-0.5 * z * z);
+
+    double a = 0.0352624965998911;
+    a = a * z + 0.700383064443688;
+    a = a * z + 6.37396220353165;
+    a = a * z + 33.912866078383;
+    a = a * z + 112.079291497871;
+    a = a * z + 221.213596169931;
+    a = a * z + 220.206867912376;
+    double b = 0.0883883476483184;
+    b = b * z + 1.75566716318264;
+    b = b * z + 16.064177579207;
+    b = b * z + 86.7807322029461;
+    b = b * z + 296.564248779674;
+    b = b * z + 637.333633378831;
+    b = b * z + 793.826512519948;
+    b = b * z + 440.413735824752;
+    double near = e * a / b;
+
+    double cf = z + 1.0 / (z + 2.0 / (z + 3.0 / (z + 4.0 / (z + 0.65))));
+    double far = e / (2.5066282746310002 * cf);
+
+    double tail = select(z < 7.07106781186547, near, far);
+    return select(z > 37.0, 0.0, tail);
+}
+
+// Standard normal cdf built on normal_tail; same error bounds.
+MATH_FAST_INLINE double N(double x) {
+    double tail = normal_tail(x);
+    return select(x > 0.0, 1.0 - tail, tail);
+}
+
+// Standard normal pdf. Max relative error vs boost::math::pdf 4.4e-16.
+MATH_FAST_INLINE double n(double x) {
+    constexpr double inv_sqrt_2pi = 0.39894228040143267794;
+    return inv_sqrt_2pi * exp(-0.5 * x * x);
+}
+
+// Standard normal quantile, p in (0, 1), by Acklam's rational approximation with the
+// central and tail regions both evaluated and selected. Max relative error vs
+// boost::math::quantile 1.15e-9; for bulk random normals, where that is far below the
+// sampling noise.
+MATH_FAST_INLINE double N_inv(double p) {
+    double q = p - 0.5;
+    double r = q * q;
+    double num = -3.969683028665376e+01;
+    num = num * r + 2.209460984245205e+02;
+    num = num * r - 2.759285104469687e+02;
+    num = num * r + 1.383577518672690e+02;
+    num = num * r - 3.066479806614716e+01;
+    num = num * r + 2.506628277459239e+00;
+    double den = -5.447609879822406e+01;
+    den = den * r + 1.615858368580409e+02;
+    den = den * r - 1.556989798598866e+02;
+    den = den * r + 6.680131188771972e+01;
+    den = den * r - 1.328068155288572e+01;
+    den = den * r + 1.0;
+    double central = q * num / den;
+
+    bool upper = p > 0.5;
+    double t = sqrt(-2.0 * log(select(upper, 1.0 - p, p)));
+    double tnum = -7.784894002430293e-03;
+    tnum = tnum * t - 3.223964580411365e-01;
+    tnum = tnum * t - 2.400758277161838e+00;
+    tnum = tnum * t - 2.549732539343734e+00;
+    tnum = tnum * t + 4.374664141464968e+00;
+    tnum = tnum * t + 2.938163982698783e+00;
+    double tden = 7.784695709041462e-03;
+    tden = tden * t + 3.224671290700398e-01;
+    tden = tden * t + 2.445134137142996e+00;
+    tden = tden * t + 3.754408661907416e+00;
+    tden = tden * t + 1.0;
+    double tail = tnum / tden;
+    tail = select(upper, -tail, tail);
+
+    return select(std::fabs(q) <= 0.5 - 0.02425, central, tail);
+}
+
+} // namespace fast
+} // namespace math
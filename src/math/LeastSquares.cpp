@@ -0,0 +1,334 @@
+#include "math/LeastSquares.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/Simd.hpp"
+#include "math/FastMath.hpp"  // MATH_FAST_INLINE
+
+namespace math {
+namespace lsq {
+namespace {
+
+// Rows per block of the Gram accumulation: the columns of a block stay in L1 while
+// every column pair is multiplied.
+constexpr std::size_t GRAM_ROWS = 256;
+// Independent partial sums per dot product; a fixed-width local array lets GCC keep
+// them in vector registers at -O2.
+constexpr std::size_t DOT_LANES = 8;
+
+// Smallest pivot accepted when factoring the normal equations scaled to unit diagonal,
+// i.e. the squared sine of the angle between a column and the span of those before it.
+// Below this the squared condition number costs more digits than QR would.
+constexpr double CHOLESKY_MIN_PIVOT = 1e-8;
+// Singular values (and diagonal entries of R) below this fraction of the largest, with
+// unit-norm columns, are treated as zero.
+constexpr double RANK_TOLERANCE = 1e-12;
+constexpr std::size_t MAX_JACOBI_SWEEPS = 60;
+
+MATH_FAST_INLINE double dot(const double* x, const double* y, std::size_t count) {
+    double acc[DOT_LANES] = {};
+    std::size_t i = 0;
+    for (; i + DOT_LANES <= count; i += DOT_LANES) {
+        for (std::size_t k = 0; k < DOT_LANES; ++k) {
+            acc[k] += x[i + k] * y[i + k];
+        }
+    }
+    for (std::size_t k = 0; i < count; ++i, ++k) {
+        acc[k] += x[i] * y[i];
+    }
+    return ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+}
+
+// Adds the lower triangle of A^T A and A^T b over `count` rows; a and b point at the
+// first row.
+MATH_FAST_INLINE void gram(const double* a, std::size_t stride, std::size_t cols, const double* b,
+                           std::size_t count, double* ata, double* atb) {
+    for (std::size_t start = 0; start < count; start += GRAM_ROWS) {
+        std::size_t rows = std::min(GRAM_ROWS, count - start);
+        for (std::size_t r = 0; r < cols; ++r) {
+            const double* col_r = a + r * stride + start;
+            for (std::size_t c = 0; c <= r; ++c) {
+                ata[r * cols + c] += dot(col_r, a + c * stride + start, rows);
+            }
+            atb[r] += dot(col_r, b + start, rows);
+        }
+    }
+}
+
+using GramKernel = void (*)(const double* a, std::size_t stride, std::size_t cols, const double* b,
+                            std::size_t count, double* ata, double* atb);
+
+#ifdef CORE_SIMD_X86_DISPATCH
+__attribute__((target("avx512f,avx512dq,fma"))) void gram_avx512(const double* a, std::size_t stride,
+                                                                  std::size_t cols, const double* b,
+                                                                  std::size_t count, double* ata, double* atb) {
+    gram(a, stride, cols, b, count, ata, atb);
+}
+
+__attribute__((target("avx2,fma"))) void gram_avx2(const double* a, std::size_t stride, std::size_t cols,
+                                                   const double* b, std::size_t count, double* ata, double* atb) {
+    gram(a, stride, cols, b, count, ata, atb);
+}
+#endif
+
+void gram_baseline(const double* a, std::size_t stride, std::size_t cols, const double* b, std::size_t count,
+                   double* ata, double* atb) {
+    gram(a, stride, cols, b, count, ata, atb);
+}
+
+GramKernel gram_kernel() {
+#ifdef CORE_SIMD_X86_DISPATCH
+    switch (core::detect_simd_level()) {
+        case core::SimdLevel::AVX512:
+            return gram_avx512;
+        case core::SimdLevel::AVX2:
+            return gram_avx2;
+        case core::SimdLevel::Scalar:
+            break;
+    }
+#endif
+    return gram_baseline;
+}
+
+} // namespace
+
+void NormalEquations::reset(std::size_t cols) {
+    cols_ = cols;
+    ata_.assign(cols * cols, 0.0);
+    atb_.assign(cols, 0.0);
+}
+
+void NormalEquations::accumulate(const DesignMatrix& a, const double* b, std::size_t begin, std::size_t end) {
+    if (end <= begin) {
+        return;
+    }
+    static const GramKernel kernel = gram_kernel();
+    kernel(a.data + begin, a.stride, cols_, b + begin, end - begin, ata_.data(), atb_.data());
+    for (std::size_t r = 0; r < cols_; ++r) {
+        for (std::size_t c = 0; c < r; ++c) {
+            ata_[c * cols_ + r] = ata_[r * cols_ + c];
+        }
+    }
+}
+
+void NormalEquations::add(const NormalEquations& other) {
+    for (std::size_t i = 0; i < ata_.size(); ++i) {
+        ata_[i] += other.ata_[i];
+    }
+    for (std::size_t i = 0; i < atb_.size(); ++i) {
+        atb_[i] += other.atb_[i];
+    }
+}
+
+void LeastSquaresSolver::setScale(const NormalEquations& normal) {
+    const std::size_t n = normal.cols();
+    scale_.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        double norm = std::sqrt(normal.ata()[j * n + j]);
+        scale_[j] = norm > 0.0 && std::isfinite(norm) ? norm : 1.0;
+    }
+}
+
+bool LeastSquaresSolver::solveNormal(const NormalEquations& normal, double* x) {
+    if (method_ != Method::Cholesky) {
+        return false;
+    }
+    setScale(normal);
+    return cholesky(normal, x);
+}
+
+Method LeastSquaresSolver::solve(const NormalEquations& normal, const DesignMatrix& a, const double* b,
+                                 double* x) {
+    setScale(normal);
+    if (method_ == Method::Cholesky && cholesky(normal, x)) {
+        return Method::Cholesky;
+    }
+    if (householder(a, b) && method_ != Method::SVD) {
+        solveR(x);
+        return Method::QR;
+    }
+    solveSvd(x);
+    return Method::SVD;
+}
+
+bool LeastSquaresSolver::cholesky(const NormalEquations& normal, double* x) {
+    const std::size_t n = normal.cols();
+    const double* ata = normal.ata();
+    work_.resize(n * n);
+    double* L = work_.data();
+    for (std::size_t j = 0; j < n; ++j) {
+        for (std::size_t i = j; i < n; ++i) {
+            double sum = ata[i * n + j] / (scale_[i] * scale_[j]);
+            for (std::size_t k = 0; k < j; ++k) {
+                sum -= L[i * n + k] * L[j * n + k];
+            }
+            if (i == j) {
+                if (!(sum > CHOLESKY_MIN_PIVOT)) {
+                    return false;
+                }
+                L[j * n + j] = std::sqrt(sum);
+            } else {
+                L[i * n + j] = sum / L[j * n + j];
+            }
+        }
+    }
+
+    // L L^T y = D^{-1/2} A^T b, x = D^{-1/2} y.
+    for (std::size_t i = 0; i < n; ++i) {
+        double sum = normal.atb()[i] / scale_[i];
+        for (std::size_t k = 0; k < i; ++k) {
+            sum -= L[i * n + k] * x[k];
+        }
+        x[i] = sum / L[i * n + i];
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        double sum = x[i];
+        for (std::size_t k = i + 1; k < n; ++k) {
+            sum -= L[k * n + i] * x[k];
+        }
+        x[i] = sum / L[i * n + i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] /= scale_[i];
+    }
+    return true;
+}
+
+bool LeastSquaresSolver::householder(const DesignMatrix& a, const double* b) {
+    const std::size_t n = a.cols;
+    // Padding to at least n rows keeps the n x n factor R addressable when rows < cols.
+    const std::size_t m = std::max(a.rows, n);
+    work_.assign(m * n, 0.0);
+    qtb_.assign(m, 0.0);
+    for (std::size_t j = 0; j < n; ++j) {
+        const double* col = a.column(j);
+        double inv_scale = 1.0 / scale_[j];
+        for (std::size_t i = 0; i < a.rows; ++i) {
+            work_[j * m + i] = col[i] * inv_scale;
+        }
+    }
+    std::copy(b, b + a.rows, qtb_.begin());
+
+    double max_diag = 0.0;
+    for (std::size_t j = 0; j < n; ++j) {
+        double* v = work_.data() + j * m + j;
+        const std::size_t len = m - j;
+        double tail = len > 1 ? dot(v + 1, v + 1, len - 1) : 0.0;
+        double norm = std::sqrt(v[0] * v[0] + tail);
+        if (norm == 0.0) {
+            continue;
+        }
+        // H = I - beta v v^T with v = x - alpha e_1 maps the column to alpha e_1.
+        double alpha = v[0] > 0.0 ? -norm : norm;
+        v[0] -= alpha;
+        double beta = 2.0 / (v[0] * v[0] + tail);
+        for (std::size_t k = j + 1; k < n; ++k) {
+            double* col = work_.data() + k * m + j;
+            double t = beta * dot(v, col, len);
+            for (std::size_t i = 0; i < len; ++i) {
+                col[i] -= t * v[i];
+            }
+        }
+        double t = beta * dot(v, qtb_.data() + j, len);
+        for (std::size_t i = 0; i < len; ++i) {
+            qtb_[j + i] -= t * v[i];
+        }
+        v[0] = alpha;
+        max_diag = std::max(max_diag, norm);
+    }
+
+    // Only R (the upper triangle of the top n rows) is needed from here on.
+    for (std::size_t j = 0; j < n; ++j) {
+        std::fill(work_.begin() + j * m + j + 1, work_.begin() + j * m + n, 0.0);
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        if (!(std::fabs(work_[j * m + j]) > RANK_TOLERANCE * max_diag)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void LeastSquaresSolver::solveR(double* x) const {
+    const std::size_t n = scale_.size();
+    const std::size_t m = qtb_.size();
+    for (std::size_t i = n; i-- > 0;) {
+        double sum = qtb_[i];
+        for (std::size_t k = i + 1; k < n; ++k) {
+            sum -= work_[k * m + i] * x[k];
+        }
+        x[i] = sum / work_[i * m + i];
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] /= scale_[i];
+    }
+}
+
+void LeastSquaresSolver::solveSvd(double* x) {
+    // One-sided Jacobi on R: rotate column pairs of W = R until they are orthogonal, so
+    // W = U Sigma with V accumulating the rotations and R = U Sigma V^T.
+    const std::size_t n = scale_.size();
+    const std::size_t m = qtb_.size();
+    v_.assign(n * n, 0.0);
+    for (std::size_t j = 0; j < n; ++j) {
+        v_[j * n + j] = 1.0;
+    }
+    auto W = [&](std::size_t j) { return work_.data() + j * m; };
+    const double eps = std::numeric_limits<double>::epsilon();
+    for (std::size_t sweep = 0; sweep < MAX_JACOBI_SWEEPS; ++sweep) {
+        bool rotated = false;
+        for (std::size_t p = 0; p + 1 < n; ++p) {
+            for (std::size_t q = p + 1; q < n; ++q) {
+                double alpha = dot(W(p), W(p), n);
+                double beta = dot(W(q), W(q), n);
+                double gamma = dot(W(p), W(q), n);
+                if (std::fabs(gamma) <= eps * std::sqrt(alpha * beta)) {
+                    continue;
+                }
+                rotated = true;
+                double zeta = (beta - alpha) / (2.0 * gamma);
+                double t = std::copysign(1.0, zeta) / (std::fabs(zeta) + std::sqrt(1.0 + zeta * zeta));
+                double c = 1.0 / std::sqrt(1.0 + t * t);
+                double s = c * t;
+                for (std::size_t i = 0; i < n; ++i) {
+                    double wp = W(p)[i];
+                    double wq = W(q)[i];
+                    W(p)[i] = c * wp - s * wq;
+                    W(q)[i] = s * wp + c * wq;
+                    double vp = v_[p * n + i];
+                    double vq = v_[q * n + i];
+                    v_[p * n + i] = c * vp - s * vq;
+                    v_[q * n + i] = s * vp + c * vq;
+                }
+            }
+        }
+        if (!rotated) {
+            break;
+        }
+    }
+
+    double sigma_max = 0.0;
+    for (std::size_t j = 0; j < n; ++j) {
+        sigma_max = std::max(sigma_max, std::sqrt(dot(W(j), W(j), n)));
+    }
+    // x = V Sigma^+ U^T (Q^T b), with U_j Sigma_j = W_j.
+    std::fill(x, x + n, 0.0);
+    for (std::size_t j = 0; j < n; ++j) {
+        double sigma2 = dot(W(j), W(j), n);
+        if (!(std::sqrt(sigma2) > RANK_TOLERANCE * sigma_max)) {
+            continue;
+        }
+        double coeff = dot(W(j), qtb_.data(), n) / sigma2;
+        for (std::size_t i = 0; i < n; ++i) {
+            x[i] += coeff * v_[j * n + i];
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        x[i] /= scale_[i];
+    }
+}
+
+} // namespace lsq
+} // namespace math
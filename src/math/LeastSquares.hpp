@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Linear least squares min ||A x - b||_2 for regression-based estimators (LSMC). The
+// normal equations are accumulated over row ranges with SIMD dot products, so callers
+// can sum disjoint ranges on separate threads and merge the partials; the solver then
+// escalates from Cholesky to Householder QR to a truncated SVD as conditioning demands.
+namespace math {
+namespace lsq {
+
+enum class Method {
+    Cholesky,  // normal equations; falls back to QR when not safely positive definite
+    QR,        // Householder QR of A; falls back to SVD when A is rank deficient
+    SVD        // truncated SVD of A (via its QR factor), minimum-norm solution
+};
+
+// Column-major view of a design matrix: entry (i, j) is data[j * stride + i].
+struct DesignMatrix {
+    const double* data{nullptr};
+    std::size_t rows{0};
+    std::size_t cols{0};
+    std::size_t stride{0};
+
+    const double* column(std::size_t j) const { return data + j * stride; }
+};
+
+// A^T A and A^T b summed over rows of A. Partial sums over disjoint row ranges combine
+// with add(); merging them in a fixed order keeps the result independent of how the
+// ranges were spread over threads.
+class NormalEquations {
+  public:
+    explicit NormalEquations(std::size_t cols = 0) { reset(cols); }
+
+    // Zeroes the sums for `cols` columns; allocates only when cols grows.
+    void reset(std::size_t cols);
+
+    // Adds rows [begin, end) of `a`, with b indexed like the rows of a.
+    void accumulate(const DesignMatrix& a, const double* b, std::size_t begin, std::size_t end);
+
+    void add(const NormalEquations& other);
+
+    std::size_t cols() const { return cols_; }
+    const double* ata() const { return ata_.data(); }  // row-major, symmetric
+    const double* atb() const { return atb_.data(); }
+
+  private:
+    std::size_t cols_{0};
+    std::vector<double> ata_;
+    std::vector<double> atb_;
+};
+
+// Keeps its scratch across calls, so a solver reused for every regression of a backward
+// induction allocates only on its first QR or SVD.
+class LeastSquaresSolver {
+  public:
+    explicit LeastSquaresSolver(Method method = Method::Cholesky) : method_(method) {}
+
+    // Writes the a.cols coefficients to x and returns the method that produced them.
+    // `normal` must hold the sums of (a, b) over all rows of a; QR and SVD read a and b.
+    Method solve(const NormalEquations& normal, const DesignMatrix& a, const double* b, double* x);
+
+    // Cholesky on the normal equations alone, for callers that only materialise A when
+    // it is needed. False, with x untouched, unless the method is Cholesky and the
+    // factorisation succeeds; solve() then finishes the job.
+    bool solveNormal(const NormalEquations& normal, double* x);
+
+    Method method() const { return method_; }
+
+  private:
+    void setScale(const NormalEquations& normal);
+    bool cholesky(const NormalEquations& normal, double* x);
+    // Factors a with unit-norm columns into work_ (R in the top rows) and qtb_; false
+    // when R is numerically singular.
+    bool householder(const DesignMatrix& a, const double* b);
+    void solveR(double* x) const;
+    void solveSvd(double* x);
+
+    Method method_;
+    std::vector<double> work_;   // Cholesky factor, or A with Householder vectors
+    std::vector<double> scale_;  // column norms
+    std::vector<double> qtb_;    // Q^T b
+    std::vector<double> v_;      // right singular vectors
+};
+
+} // namespace lsq
+} // namespace math
@@ -4,6 +4,7 @@
 
 namespace math {
 namespace normal {
+namespace reference {
 
 double n(double x) {
     static const boost::math::normal_distribution<double> dist(0.0, 1.0);
@@ -15,5 +16,11 @@ double N(double x) {
     return boost::math::cdf(dist, x);
 }
 
+double N_inv(double p) {
+    static const boost::math::normal_distribution<double> dist(0.0, 1.0);
+    return boost::math::quantile(dist, p);
+}
+
+} // namespace reference
 } // namespace normal
 } // namespace math
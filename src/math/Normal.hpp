@@ -1,10 +1,212 @@
 #pragma once
 
+#include <cmath>
+
+#include "math/FastMath.hpp"
+
+// Standard normal pdf, cdf and quantile in three tiers:
+//   n / N / N_inv            double precision, inline (Cody cdf, Wichura AS241 quantile)
+//   N_fast / N_inv_fast      ~1e-7 / ~1e-9, branch-free or nearly so, for inner loops
+//   reference::n / N / N_inv Boost.Math, out of line, for validation
+// The branch-free SIMD variants used by batch kernels live in math::fast.
+
 namespace math {
 namespace normal {
 
-double n(double x); // standard normal pdf
-double N(double x); // standard normal cdf
+namespace reference {
+
+double n(double x); // standard normal pdf (Boost)
+double N(double x); // standard normal cdf (Boost)
+double N_inv(double p); // standard normal quantile, p in (0, 1) (Boost)
+
+} // namespace reference
+
+// Standard normal pdf. Max relative error vs reference::n 4.4e-16.
+inline double n(double x) {
+    return math::fast::n(x);
+}
+
+// Standard normal cdf by Cody's rational Chebyshev approximations (ACM TOMS 715,
+// ANORM), with the Gaussian factor split as in the original to keep relative accuracy
+// in the tails. Max relative error 8e-16 for x in [-37, 8] against long-double Boost;
+// reference::N (double) itself drifts to ~2e-13 relative near x = -37.
+inline double N(double x) {
+    constexpr double inv_sqrt_2pi = 0.39894228040143267794;
+    double y = std::fabs(x);
+
+    if (y <= 0.67448975) {
+        double z = x * x;
+        double num = 0.065682337918207449113 * z;
+        double den = z;
+        num = (num + 2.2352520354606839287) * z;
+        den = (den + 47.20258190468824187) * z;
+        num = (num + 161.02823106855587881) * z;
+        den = (den + 976.09855173777669322) * z;
+        num = (num + 1067.6894854603709582) * z;
+        den = (den + 10260.932208618978205) * z;
+        return 0.5 + x * (num + 18154.981253343561249) / (den + 45507.789335026729956);
+    }
+
+    double tail;
+    if (y <= 5.656854249492380195) {
+        double num = 1.0765576773720192317e-8 * y;
+        double den = y;
+        num = (num + 0.39894151208813466764) * y;
+        den = (den + 22.266688044328115691) * y;
+        num = (num + 8.8831497943883759412) * y;
+        den = (den + 235.38790178262499861) * y;
+        num = (num + 93.506656132177855979) * y;
+        den = (den + 1519.377599407554805) * y;
+        num = (num + 597.27027639480026226) * y;
+        den = (den + 6485.558298266760755) * y;
+        num = (num + 2494.5375852903726711) * y;
+        den = (den + 18615.571640885098091) * y;
+        num = (num + 6848.1904505362823326) * y;
+        den = (den + 34900.952721145977266) * y;
+        num = (num + 11602.651437647350124) * y;
+        den = (den + 38912.003286093271411) * y;
+        tail = (num + 9842.7148383839780218) / (den + 19685.429676859990727);
+    } else {
+        double z = 1.0 / (y * y);
+        double num = 0.02307344176494017303 * z;
+        double den = z;
+        num = (num + 0.21589853405795699) * z;
+        den = (den + 1.28426009614491121) * z;
+        num = (num + 0.1274011611602473639) * z;
+        den = (den + 0.468238212480865118) * z;
+        num = (num + 0.022235277870649807) * z;
+        den = (den + 0.0659881378689285515) * z;
+        num = (num + 0.001421619193227893466) * z;
+        den = (den + 0.00378239633202758244) * z;
+        tail = (inv_sqrt_2pi - z * (num + 2.9112874951168792e-5) / (den + 7.29751555083966205e-5)) / y;
+    }
+    // exp(-y^2/2) as exp(-h^2/2) exp(-(y-h)(y+h)/2) with h = y rounded down to 1/16,
+    // so the large part of the exponent is exact.
+    double h = std::trunc(16.0 * y) / 16.0;
+    tail *= std::exp(-0.5 * h * h) * std::exp(-0.5 * (y - h) * (y + h));
+    return x > 0.0 ? 1.0 - tail : tail;
+}
+
+// Standard normal quantile, p in (0, 1), by Wichura's AS241 (PPND16). Max relative
+// error vs reference::N_inv about 1e-15.
+inline double N_inv(double p) {
+    double q = p - 0.5;
+    if (std::fabs(q) <= 0.425) {
+        double r = 0.180625 - q * q;
+        double num = 2.5090809287301226727e+3;
+        num = num * r + 3.3430575583588128105e+4;
+        num = num * r + 6.7265770927008700853e+4;
+        num = num * r + 4.5921953931549871457e+4;
+        num = num * r + 1.3731693765509461125e+4;
+        num = num * r + 1.9715909503065514427e+3;
+        num = num * r + 1.3314166789178437745e+2;
+        num = num * r + 3.3871328727963666080e+0;
+        double den = 5.2264952788528545610e+3;
+        den = den * r + 2.8729085735721942674e+4;
+        den = den * r + 3.9307895800092710610e+4;
+        den = den * r + 2.1213794301586595867e+4;
+        den = den * r + 5.3941960214247511077e+3;
+        den = den * r + 6.8718700749205790830e+2;
+        den = den * r + 4.2313330701600911252e+1;
+        den = den * r + 1.0;
+        return q * num / den;
+    }
+
+    double r = std::sqrt(-std::log(q < 0.0 ? p : 1.0 - p));
+    double x;
+    if (r <= 5.0) {
+        r -= 1.6;
+        double num = 7.74545014278341407640e-4;
+        num = num * r + 2.27238449892691845833e-2;
+        num = num * r + 2.41780725177450611770e-1;
+        num = num * r + 1.27045825245236838258e+0;
+        num = num * r + 3.64784832476320460504e+0;
+        num = num * r + 5.76949722146069140550e+0;
+        num = num * r + 4.63033784615654529590e+0;
+        num = num * r + 1.42343711074968357734e+0;
+        double den = 1.05075007164441684324e-9;
+        den = den * r + 5.47593808499534494600e-4;
+        den = den * r + 1.51986665636164571966e-2;
+        den = den * r + 1.48103976427480074590e-1;
+        den = den * r + 6.89767334985100004550e-1;
+        den = den * r + 1.67638483018380384940e+0;
+        den = den * r + 2.05319162663775882187e+0;
+        den = den * r + 1.0;
+        x = num / den;
+    } else {
+        r -= 5.0;
+        double num = 2.01033439929228813265e-7;
+        num = num * r + 2.71155556874348757815e-5;
+        num = num * r + 1.24266094738807843860e-3;
+        num = num * r + 2.65321895265761230930e-2;
+        num = num * r + 2.96560571828504891230e-1;
+        num = num * r + 1.78482653991729133580e+0;
+        num = num * r + 5.46378491116411436990e+0;
+        num = num * r + 6.65790464350110377720e+0;
+        double den = 2.04426310338993978564e-15;
+        den = den * r + 1.42151175831644588870e-7;
+        den = den * r + 1.84631831751005468180e-5;
+        den = den * r + 7.86869131145613259100e-4;
+        den = den * r + 1.48753612908506148525e-2;
+        den = den * r + 1.36929880922735805310e-1;
+        den = den * r + 5.99832206555887937690e-1;
+        den = den * r + 1.0;
+        x = num / den;
+    }
+    return q < 0.0 ? -x : x;
+}
+
+// Standard normal cdf to ~1e-7: Zelen & Severo (Abramowitz & Stegun 26.2.17), branch
+// free. Max absolute error vs reference::N 7.5e-8.
+inline double N_fast(double x) {
+    double t = 1.0 / (1.0 + 0.2316419 * std::fabs(x));
+    double poly = 1.330274429;
+    poly = poly * t - 1.821255978;
+    poly = poly * t + 1.781477937;
+    poly = poly * t - 0.356563782;
+    poly = poly * t + 0.319381530;
+    double tail = n(x) * t * poly;
+    return math::fast::select(x > 0.0, 1.0 - tail, tail);
+}
+
+// Standard normal quantile to ~1e-9: Acklam's rational approximation. Max relative
+// error vs reference::N_inv 1.15e-9.
+inline double N_inv_fast(double p) {
+    constexpr double p_low = 0.02425;
+    if (p >= p_low && p <= 1.0 - p_low) {
+        double q = p - 0.5;
+        double r = q * q;
+        double num = -3.969683028665376e+01;
+        num = num * r + 2.209460984245205e+02;
+        num = num * r - 2.759285104469687e+02;
+        num = num * r + 1.383577518672690e+02;
+        num = num * r - 3.066479806614716e+01;
+        num = num * r + 2.506628277459239e+00;
+        double den = -5.447609879822406e+01;
+        den = den * r + 1.615858368580409e+02;
+        den = den * r - 1.556989798598866e+02;
+        den = den * r + 6.680131188771972e+01;
+        den = den * r - 1.328068155288572e+01;
+        den = den * r + 1.0;
+        return q * num / den;
+    }
+
+    bool upper = p > 0.5;
+    double q = std::sqrt(-2.0 * math::fast::log(upper ? 1.0 - p : p));
+    double num = -7.784894002430293e-03;
+    num = num * q - 3.223964580411365e-01;
+    num = num * q - 2.400758277161838e+00;
+    num = num * q - 2.549732539343734e+00;
+    num = num * q + 4.374664141464968e+00;
+    num = num * q + 2.938163982698783e+00;
+    double den = 7.784695709041462e-03;
+    den = den * q + 3.224671290700398e-01;
+    den = den * q + 2.445134137142996e+00;
+    den = den * q + 3.754408661907416e+00;
+    den = den * q + 1.0;
+    double x = num / den;
+    return upper ? -x : x;
+}
 
 } // namespace normal
 } // namespace math
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "math/FastMath.hpp"
+
+namespace math {
+namespace random {
+
+// Philox4x32-10 counter-based generator (Salmon et al., 2011). Each (seed, stream)
+// pair addresses an independent sequence, so a block of work can be given its own
+// substream without sharing or jumping a stateful engine. Satisfies
+// UniformRandomBitGenerator, so it plugs into the <random> distributions.
+class Philox4x32 {
+  public:
+    using result_type = std::uint32_t;
+
+    explicit Philox4x32(std::uint64_t seed = 0, std::uint64_t stream = 0)
+        : key_{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)},
+          counter_{0u, 0u, static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)} {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+    result_type operator()() {
+        if (index_ == 4) {
+            output_ = block(counter_, key_);
+            if (++counter_[0] == 0) {
+                ++counter_[1];
+            }
+            index_ = 0;
+        }
+        return output_[index_++];
+    }
+
+    // One Philox4x32-10 evaluation: four 32-bit words from a 128-bit counter and 64-bit key.
+    static std::array<std::uint32_t, 4> block(std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> key) {
+        constexpr std::uint64_t M0 = 0xD2511F53u;
+        constexpr std::uint64_t M1 = 0xCD9E8D57u;
+        constexpr std::uint32_t W0 = 0x9E3779B9u;
+        constexpr std::uint32_t W1 = 0xBB67AE85u;
+        for (int round = 0; round < 10; ++round) {
+            std::uint64_t p0 = M0 * ctr[0];
+            std::uint64_t p1 = M1 * ctr[2];
+            ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0], static_cast<std::uint32_t>(p1),
+                   static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1], static_cast<std::uint32_t>(p0)};
+            key[0] += W0;
+            key[1] += W1;
+        }
+        return ctr;
+    }
+
+    // Words of `counters` consecutive counters of substream (seed, stream) from counter
+    // `first` on, in the order operator() returns them: out[4 i + w] is word w of counter
+    // first + i. Runs the rounds across 16 counters at a time so they vectorise; inlined
+    // so ISA-specific kernels get wide registers.
+    MATH_FAST_INLINE static void fill(std::uint64_t seed, std::uint64_t stream, std::uint64_t first,
+                                      std::size_t counters, std::uint32_t* out) {
+        constexpr std::size_t LANES = 16;
+        constexpr std::uint64_t M0 = 0xD2511F53u;
+        constexpr std::uint64_t M1 = 0xCD9E8D57u;
+        constexpr std::uint32_t W0 = 0x9E3779B9u;
+        constexpr std::uint32_t W1 = 0xBB67AE85u;
+        for (std::size_t base = 0; base < counters; base += LANES) {
+            std::uint32_t c0[LANES], c1[LANES], c2[LANES], c3[LANES];
+            for (std::size_t l = 0; l < LANES; ++l) {
+                std::uint64_t index = first + base + l;
+                c0[l] = static_cast<std::uint32_t>(index);
+                c1[l] = static_cast<std::uint32_t>(index >> 32);
+                c2[l] = static_cast<std::uint32_t>(stream);
+                c3[l] = static_cast<std::uint32_t>(stream >> 32);
+            }
+            std::uint32_t k0 = static_cast<std::uint32_t>(seed);
+            std::uint32_t k1 = static_cast<std::uint32_t>(seed >> 32);
+            for (int round = 0; round < 10; ++round) {
+                for (std::size_t l = 0; l < LANES; ++l) {
+                    std::uint64_t p0 = M0 * c0[l];
+                    std::uint64_t p1 = M1 * c2[l];
+                    std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1[l] ^ k0;
+                    std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3[l] ^ k1;
+                    c1[l] = static_cast<std::uint32_t>(p1);
+                    c3[l] = static_cast<std::uint32_t>(p0);
+                    c0[l] = n0;
+                    c2[l] = n2;
+                }
+                k0 += W0;
+                k1 += W1;
+            }
+            const std::size_t lanes = counters - base < LANES ? counters - base : LANES;
+            for (std::size_t l = 0; l < lanes; ++l) {
+                out[4 * (base + l) + 0] = c0[l];
+                out[4 * (base + l) + 1] = c1[l];
+                out[4 * (base + l) + 2] = c2[l];
+                out[4 * (base + l) + 3] = c3[l];
+            }
+        }
+    }
+
+  private:
+    std::array<std::uint32_t, 2> key_;
+    std::array<std::uint32_t, 4> counter_;
+    std::array<std::uint32_t, 4> output_{};
+    int index_{4};
+};
+
+// Standard normal draw from the next word w of `rng`, by inverting the uniform
+// (w + 1/2) 2^-32 as the block path kernels do, so |z| < 6.3. Unlike
+// std::normal_distribution, whose algorithm and draw count are up to the library, the
+// same seed gives the same normals on every toolchain.
+inline double standard_normal(Philox4x32& rng) {
+    return math::fast::N_inv((static_cast<double>(rng()) + 0.5) * 0x1p-32);
+}
+
+} // namespace random
+} // namespace math
@@ -0,0 +1,82 @@
+#include "math/Sobol.hpp"
+
+#include <stdexcept>
+
+#include <boost/random/sobol.hpp>
+
+namespace math {
+namespace qmc {
+
+namespace {
+
+std::uint32_t reverse_bits(std::uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+// Laine-Karras style hash: a random permutation of bit-reversed integers in which
+// each bit only depends on lower bits, i.e. a nested uniform (Owen) scramble.
+std::uint32_t owen_scramble(std::uint32_t x, std::uint32_t seed) {
+    x = reverse_bits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverse_bits(x);
+}
+
+std::uint64_t splitmix64(std::uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+}  // namespace
+
+struct SobolSequence::Engine {
+    explicit Engine(std::size_t dimension) : sobol(static_cast<unsigned>(dimension)) {}
+    boost::random::sobol_engine<std::uint32_t, 32, boost::random::default_sobol_table> sobol;
+};
+
+SobolSequence::SobolSequence(std::size_t dimension) : dimension_(dimension) {
+    if (dimension_ == 0 || dimension_ > MAX_DIMENSION) {
+        throw std::invalid_argument("SobolSequence: dimension must be in [1, 3667]");
+    }
+    engine_ = std::make_unique<Engine>(dimension_);
+}
+
+SobolSequence::SobolSequence(std::size_t dimension, std::uint64_t scramble_seed) : SobolSequence(dimension) {
+    scramble_seeds_.resize(dimension_);
+    std::uint64_t state = scramble_seed;
+    for (auto& s : scramble_seeds_) {
+        state = splitmix64(state);
+        s = static_cast<std::uint32_t>(state >> 32);
+    }
+}
+
+SobolSequence::~SobolSequence() = default;
+SobolSequence::SobolSequence(SobolSequence&&) noexcept = default;
+SobolSequence& SobolSequence::operator=(SobolSequence&&) noexcept = default;
+
+void SobolSequence::seek(std::uint64_t index) {
+    engine_->sobol.seed(static_cast<std::uint32_t>(index));
+}
+
+void SobolSequence::next(double* out) {
+    constexpr double inv_2_32 = 1.0 / 4294967296.0;
+    for (std::size_t d = 0; d < dimension_; ++d) {
+        std::uint32_t x = engine_->sobol();
+        if (!scramble_seeds_.empty()) {
+            x = owen_scramble(x, scramble_seeds_[d]);
+        }
+        out[d] = (static_cast<double>(x) + 0.5) * inv_2_32;
+    }
+}
+
+} // namespace qmc
+} // namespace math
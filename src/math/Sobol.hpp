@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace math {
+namespace qmc {
+
+// Sobol low-discrepancy sequence with Joe-Kuo direction numbers (Boost.Random table).
+// Points are counted from the first point after the all-zero origin and returned in
+// the open cube (0, 1)^d, so they can be fed straight into N^-1. With a scramble seed every coordinate
+// is Owen-scrambled (hash-based nested uniform scrambling, Burley 2020): each point is
+// then uniform on the cube while the set keeps its net structure, so independent
+// scrambles give i.i.d. replicates from which a standard error can be estimated.
+class SobolSequence {
+  public:
+    static constexpr std::size_t MAX_DIMENSION = 3667;
+
+    explicit SobolSequence(std::size_t dimension);
+    SobolSequence(std::size_t dimension, std::uint64_t scramble_seed);
+    ~SobolSequence();
+
+    SobolSequence(SobolSequence&&) noexcept;
+    SobolSequence& operator=(SobolSequence&&) noexcept;
+
+    std::size_t dimension() const { return dimension_; }
+
+    // Positions the sequence so that the next call to next() returns point `index`.
+    void seek(std::uint64_t index);
+
+    // Writes the next point's dimension() coordinates to `out`.
+    void next(double* out);
+
+  private:
+    struct Engine;
+
+    std::size_t dimension_;
+    std::unique_ptr<Engine> engine_;
+    std::vector<std::uint32_t> scramble_seeds_;  // empty when unscrambled
+};
+
+} // namespace qmc
+} // namespace math
@@ -2,42 +2,260 @@
 
 #include <cmath>
 
+#include "math/Normal.hpp"
+
 namespace math {
 namespace stats {
 
-double mean(const std::vector<double>& data) {
-    if (data.empty()) {
-        return 0.0;
+namespace {
+
+// Neumaier: sum + c carries the rounding error of every addition.
+inline void compensated_add(double& sum, double& c, double x) {
+    double t = sum + x;
+    if (std::fabs(sum) >= std::fabs(x)) {
+        c += (sum - t) + x;
+    } else {
+        c += (x - t) + sum;
     }
+    sum = t;
+}
+
+RunningStats of(const std::vector<double>& data) {
+    RunningStats stats;
+    stats.add(data.data(), data.size());
+    return stats;
+}
+
+} // namespace
+
+void RunningStats::add(double x) {
+    const double n1 = static_cast<double>(count_);
+    const double n = n1 + 1.0;
+    const double delta = x - mean();
+    const double delta_n = delta / n;
+    const double term = delta * delta_n * n1;
+    ++count_;
+    compensated_add(mean_, mean_c_, delta_n);
+    if (higher_moments_) {
+        const double m2 = this->m2();
+        m4_ += term * delta_n * delta_n * (n * n - 3.0 * n + 3.0) + 6.0 * delta_n * delta_n * m2 - 4.0 * delta_n * m3_;
+        m3_ += term * delta_n * (n - 2.0) - 3.0 * delta_n * m2;
+    }
+    compensated_add(m2_, m2_c_, term);
+}
+
+void RunningStats::add(const double* x, std::size_t n) {
+    if (n == 0) {
+        return;
+    }
+    RunningStats part(higher_moments_);
+    part.count_ = n;
     double sum = 0.0;
-    for (double x : data) {
-        sum += x;
+    for (std::size_t i = 0; i < n; ++i) {
+        sum += x[i];
     }
-    return sum / static_cast<double>(data.size());
+    part.mean_ = sum / static_cast<double>(n);
+    double m2 = 0.0;
+    double m3 = 0.0;
+    double m4 = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double d = x[i] - part.mean_;
+        m2 += d * d;
+    }
+    if (higher_moments_) {
+        for (std::size_t i = 0; i < n; ++i) {
+            double d = x[i] - part.mean_;
+            double d2 = d * d;
+            m3 += d2 * d;
+            m4 += d2 * d2;
+        }
+    }
+    part.m2_ = m2;
+    part.m3_ = m3;
+    part.m4_ = m4;
+    add(part);
 }
 
-double variance(const std::vector<double>& data) {
-    if (data.size() < 2) {
+void RunningStats::add(const RunningStats& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        bool higher = higher_moments_;
+        *this = other;
+        higher_moments_ = higher;
+        return;
+    }
+    const double na = static_cast<double>(count_);
+    const double nb = static_cast<double>(other.count_);
+    const double n = na + nb;
+    const double delta = other.mean() - mean();
+    const double delta2 = delta * delta;
+    const double ma2 = m2();
+    const double mb2 = other.m2();
+    if (higher_moments_) {
+        m4_ += other.m4_ + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n) +
+               6.0 * delta2 * (na * na * mb2 + nb * nb * ma2) / (n * n) +
+               4.0 * delta * (na * other.m3_ - nb * m3_) / n;
+        m3_ += other.m3_ + delta2 * delta * na * nb * (na - nb) / (n * n) + 3.0 * delta * (na * mb2 - nb * ma2) / n;
+    }
+    count_ += other.count_;
+    compensated_add(mean_, mean_c_, delta * nb / n);
+    compensated_add(m2_, m2_c_, other.m2_);
+    compensated_add(m2_, m2_c_, other.m2_c_);
+    compensated_add(m2_, m2_c_, delta2 * na * nb / n);
+}
+
+double RunningStats::variance() const {
+    if (count_ < 2) {
         return 0.0;
     }
-    double mu = mean(data);
-    double accum = 0.0;
-    for (double x : data) {
-        double diff = x - mu;
-        accum += diff * diff;
+    return std::fmax(0.0, m2()) / static_cast<double>(count_ - 1);
+}
+
+double RunningStats::standard_deviation() const {
+    return std::sqrt(variance());
+}
+
+double RunningStats::standard_error() const {
+    if (count_ == 0) {
+        return 0.0;
     }
-    return accum / static_cast<double>(data.size() - 1);
+    return standard_deviation() / std::sqrt(static_cast<double>(count_));
 }
 
-double standard_deviation(const std::vector<double>& data) {
-    return std::sqrt(variance(data));
+double RunningStats::skewness() const {
+    double m2 = this->m2();
+    if (!higher_moments_ || count_ < 2 || m2 <= 0.0) {
+        return 0.0;
+    }
+    return std::sqrt(static_cast<double>(count_)) * m3_ / std::pow(m2, 1.5);
 }
 
-double standard_error(const std::vector<double>& data) {
-    if (data.empty()) {
+double RunningStats::excess_kurtosis() const {
+    double m2 = this->m2();
+    if (!higher_moments_ || count_ < 2 || m2 <= 0.0) {
+        return 0.0;
+    }
+    return static_cast<double>(count_) * m4_ / (m2 * m2) - 3.0;
+}
+
+ConfidenceInterval RunningStats::confidence_interval(double level) const {
+    double half = 0.0;
+    if (level > 0.0 && level < 1.0) {
+        half = normal::N_inv(0.5 + 0.5 * level) * standard_error();
+    }
+    return {mean() - half, mean() + half};
+}
+
+void RunningCovariance::add(double x, double y) {
+    const double n = static_cast<double>(++count_);
+    const double dx = x - mean_x_;
+    const double dy = y - mean_y_;
+    mean_x_ += dx / n;
+    mean_y_ += dy / n;
+    m2_x_ += dx * (x - mean_x_);
+    m2_y_ += dy * (y - mean_y_);
+    c_ += dx * (y - mean_y_);
+}
+
+void RunningCovariance::add(const double* x, const double* y, std::size_t n) {
+    if (n == 0) {
+        return;
+    }
+    RunningCovariance part;
+    part.count_ = n;
+    double sx = 0.0;
+    double sy = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        sx += x[i];
+        sy += y[i];
+    }
+    part.mean_x_ = sx / static_cast<double>(n);
+    part.mean_y_ = sy / static_cast<double>(n);
+    double m2_x = 0.0;
+    double m2_y = 0.0;
+    double c = 0.0;
+    for (std::size_t i = 0; i < n; ++i) {
+        double dx = x[i] - part.mean_x_;
+        double dy = y[i] - part.mean_y_;
+        m2_x += dx * dx;
+        m2_y += dy * dy;
+        c += dx * dy;
+    }
+    part.m2_x_ = m2_x;
+    part.m2_y_ = m2_y;
+    part.c_ = c;
+    add(part);
+}
+
+void RunningCovariance::add(const RunningCovariance& other) {
+    if (other.count_ == 0) {
+        return;
+    }
+    if (count_ == 0) {
+        *this = other;
+        return;
+    }
+    const double na = static_cast<double>(count_);
+    const double nb = static_cast<double>(other.count_);
+    const double n = na + nb;
+    const double dx = other.mean_x_ - mean_x_;
+    const double dy = other.mean_y_ - mean_y_;
+    const double w = na * nb / n;
+    count_ += other.count_;
+    mean_x_ += dx * nb / n;
+    mean_y_ += dy * nb / n;
+    m2_x_ += other.m2_x_ + dx * dx * w;
+    m2_y_ += other.m2_y_ + dy * dy * w;
+    c_ += other.c_ + dx * dy * w;
+}
+
+double RunningCovariance::covariance() const {
+    if (count_ < 2) {
+        return 0.0;
+    }
+    return c_ / static_cast<double>(count_ - 1);
+}
+
+double RunningCovariance::correlation() const {
+    if (m2_x_ <= 0.0 || m2_y_ <= 0.0) {
         return 0.0;
     }
-    return standard_deviation(data) / std::sqrt(static_cast<double>(data.size()));
+    return c_ / std::sqrt(m2_x_ * m2_y_);
+}
+
+ControlVariateEstimate RunningCovariance::control_variate(double y_mean) const {
+    ControlVariateEstimate estimate;
+    estimate.value = mean_x_;
+    if (count_ == 0) {
+        return estimate;
+    }
+    // A constant control carries no information: fall back to the plain mean.
+    estimate.beta = m2_y_ > 0.0 ? c_ / m2_y_ : 0.0;
+    estimate.value = mean_x_ - estimate.beta * (mean_y_ - y_mean);
+    if (count_ > 2) {
+        double residual = std::fmax(0.0, m2_x_ - estimate.beta * c_);
+        estimate.std_dev = std::sqrt(residual / static_cast<double>(count_ - 2));
+        estimate.std_error = estimate.std_dev / std::sqrt(static_cast<double>(count_));
+    }
+    return estimate;
+}
+
+double mean(const std::vector<double>& data) {
+    return of(data).mean();
+}
+
+double variance(const std::vector<double>& data) {
+    return of(data).variance();
+}
+
+double standard_deviation(const std::vector<double>& data) {
+    return of(data).standard_deviation();
+}
+
+double standard_error(const std::vector<double>& data) {
+    return of(data).standard_error();
 }
 
 } // namespace stats
@@ -1,10 +1,96 @@
 #pragma once
 
+#include <cstddef>
 #include <vector>
 
 namespace math {
 namespace stats {
 
+struct ConfidenceInterval {
+    double lower{0.0};
+    double upper{0.0};
+};
+
+// Single-pass sample statistics: count, mean and the sum of squared deviations M2
+// (Welford), with the mean and M2 updates compensated (Neumaier) so long streams do
+// not drift. Optionally also M3 and M4 for skewness and kurtosis (Pebay). Instances
+// over disjoint parts of a sample merge exactly with add() (Chan et al.); merging in
+// a fixed order keeps results independent of how the parts were spread over threads.
+class RunningStats {
+  public:
+    explicit RunningStats(bool higher_moments = false) : higher_moments_(higher_moments) {}
+
+    void add(double x);
+
+    // Adds n values at once: their moments are taken in two passes, which vectorise,
+    // and merged in.
+    void add(const double* x, std::size_t n);
+
+    void add(const RunningStats& other);
+
+    std::size_t count() const { return count_; }
+    double mean() const { return mean_ + mean_c_; }
+    double m2() const { return m2_ + m2_c_; }
+
+    double variance() const;  // unbiased, n - 1
+    double standard_deviation() const;
+    double standard_error() const;
+
+    // Zero unless constructed with higher_moments.
+    double skewness() const;
+    double excess_kurtosis() const;
+
+    // Normal-approximation interval mean -/+ z standard_error at the two-sided `level`.
+    ConfidenceInterval confidence_interval(double level = 0.95) const;
+
+  private:
+    bool higher_moments_;
+    std::size_t count_{0};
+    double mean_{0.0};
+    double mean_c_{0.0};  // compensation terms
+    double m2_{0.0};
+    double m2_c_{0.0};
+    double m3_{0.0};
+    double m4_{0.0};
+};
+
+// Regression (control-variate) estimate of E[x] from paired samples (x, y) where E[y]
+// is known: mean_x - beta (mean_y - E[y]) with beta = Cov(x, y) / Var(y), the
+// variance-minimising coefficient. std_dev is that of the residual x - beta y, with one
+// degree of freedom spent on beta.
+struct ControlVariateEstimate {
+    double value{0.0};
+    double beta{0.0};
+    double std_dev{0.0};
+    double std_error{0.0};
+};
+
+// Single-pass means, M2 of each and co-moment C = sum (x - mean_x)(y - mean_y) of paired
+// samples, merged like RunningStats.
+class RunningCovariance {
+  public:
+    void add(double x, double y);
+    void add(const double* x, const double* y, std::size_t n);
+    void add(const RunningCovariance& other);
+
+    std::size_t count() const { return count_; }
+    double mean_x() const { return mean_x_; }
+    double mean_y() const { return mean_y_; }
+    double covariance() const;  // unbiased, n - 1
+    double correlation() const;
+
+    ControlVariateEstimate control_variate(double y_mean) const;
+
+  private:
+    std::size_t count_{0};
+    double mean_x_{0.0};
+    double mean_y_{0.0};
+    double m2_x_{0.0};
+    double m2_y_{0.0};
+    double c_{0.0};
+};
+
+// One-shot helpers over a stored sample, each a single pass of RunningStats.
 double mean(const std::vector<double>& data);
 double standard_deviation(const std::vector<double>& data);
 double standard_error(const std::vector<double>& data);